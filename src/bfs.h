@@ -0,0 +1,137 @@
+#ifndef QOSRNP_BFS_H
+#define QOSRNP_BFS_H
+
+#include <vector>
+#include <cstdint>      // uint32_t
+
+#include "header.h"
+#include "bitset.h"
+
+namespace qosrnp {
+    // type declarations.
+    struct BFSWorkspace;
+
+    // function declarations.
+    template <class G, class F>
+    size_type breadth_first_search(const G&, size_type, F, BFSWorkspace&);
+    template <class G, class F>
+    size_type breadth_first_search(const G&, size_type, F);
+    template <class G, class F>
+    size_type breadth_first_search(const G&, const std::vector<size_type>&, F,
+                                   BFSWorkspace&);
+    template <class G, class F>
+    size_type breadth_first_search(const G&, const std::vector<size_type>&, F);
+    template <class G, class F>
+    size_type breadth_first_expand(const G&, F, BFSWorkspace&);
+
+    /* @struct BFSWorkspace
+     *
+     * Working memory of a breadth first search, i.e., a bitmap of
+     * visited vertices and the vertex indices of the current and
+     * the next level. A workspace owned by the caller can be passed
+     * to many searches, which then allocate nothing once it has
+     * grown to the size of the graph. A workspace must not be
+     * shared by searches running at the same time.
+     */
+    struct BFSWorkspace {
+        typedef uint32_t     index_type;
+
+        // prepare for a search on a graph of n vertices.
+        void reset(size_type n) {
+            visited.resize(n);
+            visited.clear();
+            grey.clear();
+            temp_grey.clear();
+        }
+
+        DynamicBitset              visited;
+        // marks destinations, for searches that look for them.
+        DynamicBitset              targets;
+        std::vector<index_type>    grey;
+        std::vector<index_type>    temp_grey;
+    };
+
+    /* @fn breadth_first_search()
+     *
+     * Search graph g breadth first from src, and call reach(u, v)
+     * when v is first reached from u. The vertices of each level are
+     * expanded in the reverse order they are reached, as the
+     * traversals on adjacency lists always did, so every traversal
+     * builds the same trees. The search stops once reach() returns
+     * false. It runs in O(V + E) time.
+     * @return the number of reached vertices, src included.
+     */
+    template <class G, class F>
+    size_type
+    breadth_first_search(const G& g, size_type src, F reach, BFSWorkspace& ws) {
+        ws.reset(g.size());
+        ws.visited.set(src);
+        ws.grey.push_back(src);
+        return breadth_first_expand(g, reach, ws);
+    }
+
+    template <class G, class F>
+    size_type
+    breadth_first_search(const G& g, size_type src, F reach) {
+        BFSWorkspace    ws;
+        return breadth_first_search(g, src, reach, ws);
+    }
+
+    /* @fn breadth_first_search()
+     *
+     * Search graph g breadth first from all of srcs at once, i.e.,
+     * from a virtual vertex joined to each of them, so a vertex is
+     * reached at its least hops to the nearest source. Sources given
+     * more than once are searched from once.
+     * @return the number of reached vertices, srcs included.
+     */
+    template <class G, class F>
+    size_type
+    breadth_first_search(const G& g, const std::vector<size_type>& srcs, F reach,
+                         BFSWorkspace& ws) {
+        ws.reset(g.size());
+        for (auto &s : srcs)
+            if (!ws.visited.test_and_set(s))
+                ws.grey.push_back(s);
+        return breadth_first_expand(g, reach, ws);
+    }
+
+    template <class G, class F>
+    size_type
+    breadth_first_search(const G& g, const std::vector<size_type>& srcs, F reach) {
+        BFSWorkspace    ws;
+        return breadth_first_search(g, srcs, reach, ws);
+    }
+
+    /* @fn breadth_first_expand()
+     *
+     * Run a search whose sources are the vertices in ws.grey, which
+     * are marked visited in ws.
+     * @return the number of reached vertices, the sources included.
+     */
+    template <class G, class F>
+    size_type
+    breadth_first_expand(const G& g, F reach, BFSWorkspace& ws) {
+        size_type    cnt = ws.grey.size();
+        bool         go = true;
+
+        while (!ws.grey.empty() && go) {
+            while (!ws.grey.empty() && go) {
+                size_type u = ws.grey.back();
+                ws.grey.pop_back();
+                for_each_neighbor(g, u, [&](size_type v, double) {
+                    if (!go || ws.visited.test_and_set(v))
+                        return;
+                    ++cnt;
+                    ws.temp_grey.push_back(v);
+                    go = reach(u, v);
+                });
+            }
+            ws.grey.swap(ws.temp_grey);
+            ws.temp_grey.clear();
+        }
+        return cnt;
+    }
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef QOSRNP_BITSET_H
+#define QOSRNP_BITSET_H
+
+#include <iostream>
+#include <vector>
+#include <algorithm>    // fill()
+#include <cstdint>      // uint64_t
+
+#include "header.h"
+
+namespace qosrnp {
+    // type declarations.
+    class DynamicBitset;
+
+    // function declarations.
+    std::ostream& operator<<(std::ostream&, const DynamicBitset&);
+
+    /* @class DynamicBitset
+     *
+     * A bitset whose size is given at run time, stored as an
+     * array of 64-bit words. Bits beyond size() in the last word
+     * are always zero.
+     */
+    class DynamicBitset {
+    public:
+        typedef uint64_t     word_type;
+
+        static const size_type    WORD_BITS = 64;
+        static const size_type    NPOS = static_cast<size_type>(-1);
+
+        DynamicBitset() : _size(0), _words() {}
+        explicit DynamicBitset(size_type n)
+        : _size(n), _words(words_for(n), 0) {}
+        DynamicBitset(const DynamicBitset&) = default;
+        DynamicBitset(DynamicBitset&&) = default;
+        ~DynamicBitset() = default;
+
+        DynamicBitset& operator=(const DynamicBitset&) = default;
+        DynamicBitset& operator=(DynamicBitset&&) = default;
+
+        bool operator==(const DynamicBitset& bs) const {
+            return _size == bs._size && _words == bs._words;
+        }
+        bool operator!=(const DynamicBitset& bs) const { return !(*this == bs); }
+
+        size_type size() const { return _size; }
+        size_type words() const { return _words.size(); }
+        const word_type* data() const { return _words.data(); }
+        word_type* data() { return _words.data(); }
+
+        bool test(size_type i) const {
+            return (_words[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+        }
+        void set(size_type i) { _words[i / WORD_BITS] |= bit(i); }
+        void reset(size_type i) { _words[i / WORD_BITS] &= ~bit(i); }
+        // set the i-th bit, and return whether it was set before.
+        bool test_and_set(size_type i) {
+            word_type& w = _words[i / WORD_BITS];
+            bool       old = (w & bit(i)) != 0;
+            w |= bit(i);
+            return old;
+        }
+
+        // reset all bits, keeping the size.
+        void clear() { std::fill(_words.begin(), _words.end(), 0); }
+        // change the size, new bits are reset.
+        void resize(size_type);
+        // number of set bits.
+        size_type count() const;
+        bool any() const;
+
+        // word-wise operations on bitsets of the same size.
+        DynamicBitset& operator&=(const DynamicBitset&);
+        DynamicBitset& operator|=(const DynamicBitset&);
+        // reset the bits set in given bitset.
+        DynamicBitset& subtract(const DynamicBitset&);
+        // number of bits set here but not in given bitset.
+        size_type count_subtract(const DynamicBitset&) const;
+
+        // position of the first set bit, the first set bit after i,
+        // and the r-th (from 0) set bit, or NPOS if there is none.
+        size_type find_first() const;
+        size_type find_next(size_type) const;
+        size_type find_nth(size_type) const;
+
+    private:
+        static size_type words_for(size_type n) {
+            return (n + WORD_BITS - 1) / WORD_BITS;
+        }
+        static word_type bit(size_type i) {
+            return word_type(1) << (i % WORD_BITS);
+        }
+
+    private:
+        size_type                 _size;
+        std::vector<word_type>    _words;
+    };
+
+    void
+    DynamicBitset::resize(size_type n) {
+        _words.resize(words_for(n), 0);
+        // reset the bits beyond the new size in the last word.
+        if (n < _size && n % WORD_BITS)
+            _words.back() &= (word_type(1) << (n % WORD_BITS)) - 1;
+        _size = n;
+    }
+
+    size_type
+    DynamicBitset::count() const {
+        size_type    cnt = 0;
+        for (auto &w : _words)
+            cnt += __builtin_popcountll(w);
+        return cnt;
+    }
+
+    bool
+    DynamicBitset::any() const {
+        for (auto &w : _words)
+            if (w)
+                return true;
+        return false;
+    }
+
+    DynamicBitset&
+    DynamicBitset::operator&=(const DynamicBitset& bs) {
+        for (size_type i = 0; i < _words.size(); ++i)
+            _words[i] &= bs._words[i];
+        return *this;
+    }
+
+    DynamicBitset&
+    DynamicBitset::operator|=(const DynamicBitset& bs) {
+        for (size_type i = 0; i < _words.size(); ++i)
+            _words[i] |= bs._words[i];
+        return *this;
+    }
+
+    DynamicBitset&
+    DynamicBitset::subtract(const DynamicBitset& bs) {
+        for (size_type i = 0; i < _words.size(); ++i)
+            _words[i] &= ~bs._words[i];
+        return *this;
+    }
+
+    size_type
+    DynamicBitset::count_subtract(const DynamicBitset& bs) const {
+        size_type    cnt = 0;
+        for (size_type i = 0; i < _words.size(); ++i)
+            cnt += __builtin_popcountll(_words[i] & ~bs._words[i]);
+        return cnt;
+    }
+
+    size_type
+    DynamicBitset::find_first() const {
+        for (size_type i = 0; i < _words.size(); ++i)
+            if (_words[i])
+                return i * WORD_BITS + __builtin_ctzll(_words[i]);
+        return NPOS;
+    }
+
+    size_type
+    DynamicBitset::find_next(size_type i) const {
+        size_type    k = ++i / WORD_BITS;
+
+        if (i >= _size)
+            return NPOS;
+        // bits after i in its word.
+        word_type w = _words[k] & (~word_type(0) << (i % WORD_BITS));
+        while (!w) {
+            if (++k == _words.size())
+                return NPOS;
+            w = _words[k];
+        }
+        return k * WORD_BITS + __builtin_ctzll(w);
+    }
+
+    size_type
+    DynamicBitset::find_nth(size_type r) const {
+        for (size_type i = 0; i < _words.size(); ++i) {
+            size_type cnt = __builtin_popcountll(_words[i]);
+            if (r >= cnt) {
+                r -= cnt;
+                continue;
+            }
+            word_type w = _words[i];
+            // drop the r lowest set bits.
+            while (r--)
+                w &= w - 1;
+            return i * WORD_BITS + __builtin_ctzll(w);
+        }
+        return NPOS;
+    }
+
+    std::ostream&
+    operator<<(std::ostream& os, const DynamicBitset& bs) {
+        for (size_type i = 0; i < bs.size(); ++i)
+            os << (bs.test(i) ? '1' : '0');
+        return os;
+    }
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef QOSRNP_CONTEXT_H
+#define QOSRNP_CONTEXT_H
+
+#include <vector>
+#include <memory>       // shared_ptr
+
+#include "header.h"
+#include "node.h"
+
+namespace qosrnp {
+    // type declarations.
+    class SolveContext;
+
+    /* @class SolveContext
+     *
+     * State of one solve over a deployment of nodes, i.e., the hop
+     * budget and whether each node is switched on, which starts as
+     * the hop constraint of the node and whether it has power. The
+     * solvers read and write this overlay instead of the nodes, so
+     * the nodes are never changed, and many solves, each with its
+     * own context, may run on the same nodes at the same time.
+     * A node whose power is set is replaced, in this context only,
+     * by a copy of it having that power, which the graphs built
+     * from nodes() see, and it is switched on if the power is.
+     */
+    class SolveContext {
+    public:
+        SolveContext() : _nodes(), _copies(), _hops(), _active() {}
+        explicit SolveContext(const std::vector<Node*>&);
+        SolveContext(const SolveContext&) = default;
+        SolveContext(SolveContext&&) = default;
+        ~SolveContext() = default;
+
+        SolveContext& operator=(const SolveContext&) = default;
+        SolveContext& operator=(SolveContext&&) = default;
+
+        size_type size() const { return _nodes.size(); }
+        const std::vector<Node*>& nodes() const { return _nodes; }
+        const Node& node(size_type i) const { return *_nodes[i]; }
+        void set_power(size_type, const Node::power_type&);
+
+        const std::vector<hop_type>& hops() const { return _hops; }
+        hop_type hop(size_type i) const { return _hops[i]; }
+        void set_hop(size_type i, const hop_type& h) { _hops[i] = h; }
+
+        bool is_active(size_type i) const { return _active[i]; }
+        void activate(size_type i) { _active[i] = true; }
+        void deactivate(size_type i) { _active[i] = false; }
+
+    private:
+        // the nodes, which are only read.
+        std::vector<Node*>                         _nodes;
+        // the copies of the nodes whose power is set, shared by the
+        // copies of this context, and never changed once made.
+        std::vector<std::shared_ptr<const Node>>   _copies;
+        std::vector<hop_type>                      _hops;
+        std::vector<bool>                          _active;
+    };
+
+    SolveContext::SolveContext(const std::vector<Node*>& nds)
+    : _nodes(nds), _copies(nds.size()), _hops(), _active() {
+        for (auto &n : nds) {
+            _hops.push_back(n->hop());
+            _active.push_back(n->power() > 0.0);
+        }
+    }
+
+    void
+    SolveContext::set_power(size_type i, const Node::power_type& p) {
+        Node*    n = copy_node(*_nodes[i]);
+
+        n->set_power(p);
+        _copies[i] = std::shared_ptr<const Node>(n);
+        _nodes[i] = n;
+        _active[i] = p > 0.0;
+    }
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <set>
 #include <map>
+#include <vector>
 #include <utility>
 #include <initializer_list>
 #include <random>
@@ -11,6 +12,7 @@
 
 #include "header.h"
 #include "miscellaneous.h"
+#include "sampling.h"
 
 namespace qosrnp {
     template <typename T, typename K>
@@ -46,8 +48,8 @@ namespace qosrnp {
         void insert_family(const key_type&, const std::initializer_list<value_type>&);
         void insert_family(const key_type&, const value_type&);
 
-        std::map<key_type, std::set<value_type>> family() const { return _family; }
-        std::set<value_type> set() const { return _set; }
+        const std::map<key_type, std::set<value_type>>& family() const { return _family; }
+        const std::set<value_type>& set() const { return _set; }
 
         // search a minimum set cover of _set field using _family field,
         // using the greedy algorithm.
@@ -56,24 +58,39 @@ namespace qosrnp {
         // using the greedy algorithm.
         std::set<key_type> k_set_cover(const size_type&);
         // search a random k-set cover of _set field using _family field,
-        // using roulette wheel method.
+        // using roulette wheel method, or return an empty set if none
+        // is found.
         std::set<key_type> random_k_set_cover(std::default_random_engine&, const size_type&);
 
     private:
+        // keys of the sets covering each element, i.e., the inverted
+        // index of a family.
+        typedef std::map<value_type, std::set<key_type>>    index_type;
+
         // return the key of the set with maximal size from given family.
         key_type max_set(std::map<key_type, std::set<value_type>>&) const;
-        // return the key of a random set selected using the roulette wheel method.
-        key_type random_set(std::default_random_engine&, std::map<key_type, std::set<value_type>>&) const;
+        // return the position of a random set selected using the roulette
+        // wheel method, given the sizes of the sets in the order of keys.
+        size_type random_set(std::default_random_engine&, const FenwickTree<size_type>&) const;
+        // build the inverted index of given family.
+        index_type invert(const std::map<key_type, std::set<value_type>>&) const;
+        // delete given elements, covered by the set with given key, from
+        // the other sets of given family and from its inverted index.
+        void remove_covered(std::map<key_type, std::set<value_type>>&, index_type&,
+                            const key_type&, const std::set<value_type>&) const;
         // makde a k cover.
-        bool make_k_cover(std::map<key_type, std::set<value_type>>&, const key_type&, const size_type&) const;
+        bool make_k_cover(std::map<key_type, std::set<value_type>>&, index_type&,
+                          const key_type&, const size_type&) const;
         // find all the elements only covered by a set with given key.
-        std::set<value_type> necessary_elements(std::map<key_type, std::set<value_type>>&, const key_type&) const;
+        std::set<value_type> necessary_elements(std::map<key_type, std::set<value_type>>&,
+                                                const index_type&, const key_type&) const;
         // find all the elements that not covered only by a set with given key.
-        std::set<value_type> optional_elements(std::map<key_type, std::set<value_type>>&, const key_type&) const;
-        // check whether an element is only covered by given set.
-        bool is_necessary(std::map<key_type, std::set<value_type>>&, const key_type&, const value_type&) const;
+        std::set<value_type> optional_elements(std::map<key_type, std::set<value_type>>&,
+                                               const index_type&, const key_type&) const;
+        // check whether an element is covered by one set at most.
+        bool is_necessary(const index_type&, const value_type&) const;
         bool make_random_k_cover(std::default_random_engine&, std::map<T, std::set<K>>&, 
-                                 const T&, const size_type&) const;
+                                 index_type&, const T&, const size_type&) const;
 
     private:
         std::map<key_type, std::set<value_type>>    _family;
@@ -164,36 +181,61 @@ namespace qosrnp {
         return m;
     }
 
+    /* @fn minimum_set_cover()
+     *
+     * Greedily pick the set covering the most elements not covered
+     * yet, the one with the smallest key among equals, until the
+     * whole _set is covered. Picked sets only shrink the others, so
+     * sets are kept in buckets by their sizes when last counted, and
+     * a set is recounted only when it tops the highest bucket. If its
+     * size is still that of the bucket, no set is larger and no set
+     * of the same size has a smaller key, so it is the one a full
+     * scan would pick.
+     * @return the keys of the picked sets, or an empty set if the
+     *         family cannot cover _set.
+     */
     template <typename T, typename K>
     std::set<T>
     Cover<T,K>::minimum_set_cover() const {
-        std::set<T>                mi;
-        std::set<K>                tmp_s = _set;
-        std::map<T, std::set<K>>   tmp_f = _family;
-        T                          m;
-
+        std::set<T>                        mi;
+        std::set<K>                        tmp_s = _set, covered;
+        // sets of the family in the order of their keys.
+        std::vector<typename std::map<T, std::set<K>>::const_iterator>
+                                           sets;
+        // indices of the sets in sets, by their last counted sizes.
+        std::vector<std::set<size_type>>   buckets(1);
+        size_type                          top = 0, cnt;
+
+        for (auto itr = _family.begin(); itr != _family.end(); ++itr) {
+            sets.push_back(itr);
+            if (itr->second.size() >= buckets.size())
+                buckets.resize(itr->second.size() + 1);
+            buckets[itr->second.size()].insert(sets.size() - 1);
+        }
+        top = buckets.size() - 1;
         while (!tmp_s.empty()) {
-            // find a set with maximal size from remaining
-            // sets in the family.
-            m = max_set(tmp_f);
-            // delete each element in max from uncovered set.
-            for (auto &e : tmp_f[m])
-                tmp_s.erase(e);
-            // delete each covered element from remaining cover sets.
-            for (auto &f : tmp_f)
-                if (f.first != m)
-                    for (auto &e : tmp_f[m])
-                        f.second.erase(e);
-            // delete this max set from family.
-            tmp_f.erase(m);
-            // record this max set in the result.
-            mi.insert(m);
-            // if the whole family cannot guarantee a fully set cover,
-            // return an empty set.
-            if (tmp_f.empty() && !tmp_s.empty()) {
+            while (top > 0 && buckets[top].empty())
+                --top;
+            // no remaining set covers anything new.
+            if (top == 0) {
                 mi.clear();
                 return mi;
             }
+            size_type i = *buckets[top].begin();
+            buckets[top].erase(buckets[top].begin());
+            cnt = 0;
+            for (auto &e : sets[i]->second)
+                if (covered.find(e) == covered.end())
+                    ++cnt;
+            if (cnt < top) {
+                buckets[cnt].insert(i);
+                continue;
+            }
+            for (auto &e : sets[i]->second) {
+                covered.insert(e);
+                tmp_s.erase(e);
+            }
+            mi.insert(sets[i]->first);
         }
         return mi;
     }
@@ -204,6 +246,7 @@ namespace qosrnp {
         std::set<T>                  mi;
         std::set<K>                  tmp_s = _set;
         std::map<T, std::set<K>>     tmp_f = _family;
+        index_type                   idx = invert(tmp_f), fidx = invert(_family);
         T                            m;
 
         while (!tmp_s.empty()) {
@@ -214,24 +257,20 @@ namespace qosrnp {
             // set is larger than k, an empty set is returned
             // to notify that there is no feasible solution
             // to this instance.
-            if (!make_k_cover(tmp_f, m, k)) {
+            if (!make_k_cover(tmp_f, idx, m, k)) {
                 mi.clear();
                 return mi;
             }
             
-            for (auto &f : _family)
-                if (f.first != m)
-                    for (auto &e : tmp_f[m])
-                        f.second.erase(e);
+            remove_covered(_family, fidx, m, tmp_f[m]);
 
             for (auto &e : tmp_f[m])
                 tmp_s.erase(e);
             // delete each covered element from remaining cover sets.
-            for (auto &f : tmp_f)
-                if (f.first != m)
-                    for (auto &e : tmp_f[m])
-                        f.second.erase(e);
+            remove_covered(tmp_f, idx, m, tmp_f[m]);
             // delete this max set from family.
+            for (auto &e : tmp_f[m])
+                idx[e].erase(m);
             tmp_f.erase(m);
             // record this max set in the result.
             mi.insert(m);
@@ -245,63 +284,97 @@ namespace qosrnp {
         return mi;
     }
 
+    template <typename T, typename K>
+    typename Cover<T,K>::index_type
+    Cover<T,K>::invert(const std::map<T, std::set<K>>& f) const {
+        index_type    idx;
+
+        for (auto &s : f)
+            for (auto &e : s.second)
+                idx[e].insert(s.first);
+        return idx;
+    }
+
+    /* @fn remove_covered()
+     *
+     * Delete the elements in es, which are covered by the set with
+     * given key, from the other sets of family f, visiting only the
+     * sets that the index idx of f lists for each element.
+     */
+    template <typename T, typename K>
+    void
+    Cover<T,K>::remove_covered(std::map<T, std::set<K>>& f, index_type& idx,
+                               const T& key, const std::set<K>& es) const {
+        for (auto &e : es) {
+            auto itr = idx.find(e);
+            if (itr == idx.end())
+                continue;
+            bool own = itr->second.count(key) != 0;
+            for (auto &s : itr->second)
+                if (s != key)
+                    f[s].erase(e);
+            itr->second.clear();
+            if (own)
+                itr->second.insert(key);
+        }
+    }
+
     template <typename T, typename K>
     bool
-    Cover<T,K>::make_k_cover(std::map<T, std::set<K>>& f, 
+    Cover<T,K>::make_k_cover(std::map<T, std::set<K>>& f, index_type& idx,
                              const T& key, const size_type& k) const {
-        size_type           num;
         std::set<K>         nec, opt;
 
-        nec = necessary_elements(f, key);
-        opt = optional_elements(f, key);
+        nec = necessary_elements(f, idx, key);
+        opt = optional_elements(f, idx, key);
 
         if (nec.size() > k)
             return false;
 
-        f[key].clear();
-        for (auto &e : nec)
-            f[key].insert(e);
+        f[key] = nec;
         for (auto &e : opt)
-            if (f[key].size() == k)
-                break;
-            else
+            if (f[key].size() < k)
                 f[key].insert(e);
+            else
+                idx[e].erase(key);
 
         return true;
     }
 
     template <typename T, typename K>
     std::set<K>
-    Cover<T,K>::necessary_elements(std::map<T, std::set<K>>& f, const T& key) const {
+    Cover<T,K>::necessary_elements(std::map<T, std::set<K>>& f, const index_type& idx,
+                                   const T& key) const {
         std::set<K>    necs;
 
         for (auto &e : f[key])
-            if (is_necessary(f, key, e))
+            if (is_necessary(idx, e))
                 necs.insert(e);
         return necs;
     }
 
     template <typename T, typename K>
     std::set<K>
-    Cover<T,K>::optional_elements(std::map<T, std::set<K>>& f, const T& key) const {
+    Cover<T,K>::optional_elements(std::map<T, std::set<K>>& f, const index_type& idx,
+                                  const T& key) const {
         std::set<K>   opts;
 
         for (auto &e : f[key])
-            if (!is_necessary(f, key, e))
+            if (!is_necessary(idx, e))
                 opts.insert(e);
         return opts;
     }
 
+    /* @fn is_necessary()
+     *
+     * An element of a set is necessary if no other set covers it,
+     * i.e., the index lists that set only.
+     */
     template <typename T, typename K>
     bool
-    Cover<T,K>::is_necessary(std::map<T, std::set<K>>& f, const key_type& key,
-                             const value_type& val) const {
-        for (auto &s : f)
-            if (s.first != key)
-                for (auto &e : s.second)
-                    if (e == val)
-                        return false;
-        return true;
+    Cover<T,K>::is_necessary(const index_type& idx, const value_type& val) const {
+        auto itr = idx.find(val);
+        return itr == idx.end() || itr->second.size() <= 1;
     }
 
     template <typename T, typename K>
@@ -311,35 +384,57 @@ namespace qosrnp {
         std::set<T>                  mi;
         std::set<K>                  tmp_s = _set;
         std::map<T, std::set<K>>     tmp_f = _family;
+        index_type                   idx = invert(tmp_f), fidx = invert(_family);
+        // keys in their order, their positions, and the sizes of their
+        // sets by position.
+        std::vector<T>               keys;
+        std::map<T, size_type>       pos;
+        FenwickTree<size_type>       sizes(tmp_f.size());
+        std::set<T>                  touched;
         T                            m;
 
+        for (auto &f : tmp_f) {
+            pos[f.first] = keys.size();
+            sizes.set(keys.size(), f.second.size());
+            keys.push_back(f.first);
+        }
         while (!tmp_s.empty()) {
-            m = random_set(en, tmp_f);
+            // no set covers anything left.
+            if (sizes.total() == 0) {
+                mi.clear();
+                return mi;
+            }
+            m = keys[random_set(en, sizes)];
             // make this set covers no more k elements.
             // If we cannot make this successfully, i.e.,
             // the number of elements covered only by this
             // set is larger than k, an empty set is returned
             // to notify that there is no feasible solution
             // to this instance.
-            if (!make_random_k_cover(en, tmp_f, m, k)) {
+            if (!make_random_k_cover(en, tmp_f, idx, m, k)) {
                 mi.clear();
                 return mi;
             }
             
-            for (auto &f : _family)
-                if (f.first != m)
-                    for (auto &e : tmp_f[m])
-                        f.second.erase(e);
+            remove_covered(_family, fidx, m, tmp_f[m]);
 
             for (auto &e : tmp_f[m])
                 tmp_s.erase(e);
+            // the sets sharing elements with this set shrink.
+            touched.clear();
+            for (auto &e : tmp_f[m])
+                for (auto &f : idx[e])
+                    touched.insert(f);
             // delete each covered element from remaining cover sets.
-            for (auto &f : tmp_f)
-                if (f.first != m)
-                    for (auto &e : tmp_f[m])
-                        f.second.erase(e);
+            remove_covered(tmp_f, idx, m, tmp_f[m]);
             // delete this max set from family.
+            for (auto &e : tmp_f[m])
+                idx[e].erase(m);
             tmp_f.erase(m);
+            for (auto &f : touched)
+                if (f != m)
+                    sizes.set(pos[f], tmp_f[f].size());
+            sizes.set(pos[m], 0);
             // record this max set in the result.
             mi.insert(m);
             // if the whole family cannot guarantee a fully set cover,
@@ -352,41 +447,36 @@ namespace qosrnp {
         return mi;
     }
 
+    /* @fn random_set()
+     *
+     * Draw r from [0, total size], and pick the first non-empty set
+     * whose elements, counted on from the sets before it, reach r.
+     * The sizes are kept in a Fenwick tree, so a draw takes O(log n)
+     * time rather than a scan of the family. Some set must be
+     * non-empty.
+     */
     template <typename T, typename K>
-    T
+    size_type
     Cover<T,K>::random_set(std::default_random_engine& en,
-                           std::map<T, std::set<K>>& f) const {
-        size_type size = 0;
-
-        for (auto &s : f)
-            size += s.second.size();
+                           const FenwickTree<size_type>& sizes) const {
+        size_type size = sizes.total();
 
-        if (size == 0)
-            throw std::range_error("no feasible set!");
-        
         std::uniform_int_distribution<int> dis(0, size);
-        int    r = dis(en), i = 0;
-
-        for (auto &s : f) {
-            if (s.second.size() == 0) continue;
-            if (i <= r && r <= i + s.second.size())
-                return s.first;
-            i += s.second.size();
-        }
+        size_type    r = dis(en);
 
+        // the first set reaching 0 may be empty, reaching 1 may not.
+        return sizes.lower_bound(r == 0 ? 1 : r);
     }
 
     template <typename T, typename K>
     bool
     Cover<T,K>::make_random_k_cover(std::default_random_engine& en,
-                                    std::map<T, std::set<K>>& f, 
+                                    std::map<T, std::set<K>>& f, index_type& idx,
                                     const T& key, const size_type& k) const {
-        size_type           num;
         std::set<K>         nec, opt;
-        int                 i, r;
 
-        nec = necessary_elements(f, key);
-        opt = optional_elements(f, key);
+        nec = necessary_elements(f, idx, key);
+        opt = optional_elements(f, idx, key);
 
         if (nec.size() > k)
             return false;
@@ -395,15 +485,20 @@ namespace qosrnp {
         for (auto &e : nec)
             f[key].insert(e);
 
-        while (f[key].size() < k && !opt.empty()) {
-            i = 0; r = rand_range(en, 0, opt.size() - 1);
-            for (auto &e : opt)
-                if (i++ == r) {
-                    f[key].insert(e);
-                    opt.erase(e);
-                    break;
-                }
+        // pick the r-th remaining optional element as the first one
+        // whose count of remaining elements up to it reaches r + 1.
+        std::vector<K>            elems(opt.begin(), opt.end());
+        FenwickTree<size_type>    left(elems.size());
+        for (size_type i = 0; i < elems.size(); ++i)
+            left.set(i, 1);
+        while (f[key].size() < k && left.total() > 0) {
+            size_type i = left.lower_bound(rand_range(en, 0, left.total() - 1) + 1);
+            f[key].insert(elems[i]);
+            left.set(i, 0);
         }
+        for (size_type i = 0; i < elems.size(); ++i)
+            if (left.weight(i))
+                idx[elems[i]].erase(key);
 
         return true;
     }
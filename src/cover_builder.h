@@ -0,0 +1,42 @@
+#ifndef QOSRNP_COVER_BUILDER_H
+#define QOSRNP_COVER_BUILDER_H
+
+#include "header.h"
+#include "bitset.h"
+#include "dense_cover.h"
+
+namespace qosrnp {
+    // function declarations.
+    template <class G, class Itr, class P>
+    DenseCover frontier_cover(const G&, Itr, Itr, P);
+
+    /* @fn frontier_cover()
+     *
+     * Build the cover instance of one step of the c1np main loop on
+     * graph g: the frontier [b, e) is the set to cover, and vertex v
+     * covers its neighbor t in the frontier if covers(v, t) holds,
+     * e.g., v is close enough to the sink to relay the packets of t.
+     * As edges go both ways, the sets are found from the neighbors
+     * of the frontier, so building costs the total degree of the
+     * frontier rather than a scan of every edge in g.
+     */
+    template <class G, class Itr, class P>
+    DenseCover
+    frontier_cover(const G& g, Itr b, Itr e, P covers) {
+        DenseCover       cvr(g.size());
+        DynamicBitset    frontier(g.size());
+
+        for (Itr itr = b; itr != e; ++itr)
+            frontier.set(*itr);
+        cvr.insert_set(frontier);
+        for (size_type t = frontier.find_first(); t != DynamicBitset::NPOS;
+             t = frontier.find_next(t))
+            for_each_neighbor(g, t, [&](size_type v, double) {
+                if (covers(v, t))
+                    cvr.insert_family(v, t);
+            });
+        return cvr;
+    }
+}
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef QOSRNP_CSR_GRAPH_H
+#define QOSRNP_CSR_GRAPH_H
+
+#include <iostream>
+#include <vector>
+#include <cstdint>      // uint32_t
+#include <stdexcept>
+
+#include "header.h"
+#include "node.h"
+#include "graph.h"
+
+namespace qosrnp {
+    // type declarations.
+    template <class C> class CSRGraph;
+
+    // function declarations.
+    template <class C, class F>
+    void for_each_neighbor(const CSRGraph<C>&, size_type, F);
+    template <class C>
+    std::ostream& operator<<(std::ostream&, const CSRGraph<C>&);
+
+    /* @class CSRGraph
+     *
+     * Immutable undirected graph in the compressed sparse row
+     * format. The neighbors of the i-th vertex are the vertex
+     * indices _neighbors[_offsets[i]] ... _neighbors[_offsets[i+1]-1],
+     * and, if the graph is weighted, the weights of these edges
+     * are stored at the same positions in _weights. An edge costs
+     * 4 bytes (12 bytes if weighted), compared with 24 bytes of an
+     * Edge in an AdjacencyList, and neighbor scans are sequential.
+     * Vertex indices are 32-bit, so a graph holds less than 2^32
+     * vertices and directed edges.
+     */
+    template <class C>
+    class CSRGraph {
+    public:
+        typedef C                                       node_type;
+        typedef uint32_t                                index_type;
+        typedef typename Edge<C>::weight_type           weight_type;
+        typedef typename std::vector<index_type>::const_iterator
+                                                        const_iterator;
+
+        CSRGraph() : _nodes(), _offsets(1, 0), _neighbors(), _weights() {}
+        template <class Itr> CSRGraph(Itr, Itr, build_mode = build_mode::GRID,
+                                      const quality_type& = ANY_QUALITY);
+        explicit CSRGraph(const AdjacencyList<C>&);
+        CSRGraph(const CSRGraph&) = default;
+        CSRGraph(CSRGraph&&) = default;
+        ~CSRGraph() = default;
+
+        CSRGraph& operator=(const CSRGraph&) = default;
+        CSRGraph& operator=(CSRGraph&&) = default;
+
+        size_type   size() const { return _nodes.size(); }
+        size_type   edges() const { return _neighbors.size(); }
+        bool        weighted() const { return !_weights.empty(); }
+        node_type*  node(size_type i) const { return _nodes[i]; }
+        size_type   degree(size_type i) const { return _offsets[i + 1] - _offsets[i]; }
+
+        const_iterator begin(size_type i) const { return _neighbors.begin() + _offsets[i]; }
+        const_iterator end(size_type i) const { return _neighbors.begin() + _offsets[i + 1]; }
+        size_type  offset(size_type i) const { return _offsets[i]; }
+        // tail and weight of the k-th edge, i.e., the edge stored at
+        // position k of the neighbor array.
+        index_type neighbor(size_type k) const { return _neighbors[k]; }
+        weight_type weight(size_type k) const {
+            return _weights.empty() ? Edge<C>::DEFAULT_WEIGHT : _weights[k];
+        }
+
+    private:
+        void check_size() const;
+
+    private:
+        std::vector<node_type*>     _nodes;
+        std::vector<index_type>     _offsets;
+        std::vector<index_type>     _neighbors;
+        std::vector<weight_type>    _weights;
+    };
+
+    /* @fn CSRGraph()
+     *
+     * Build a graph whose vertices are the nodes in [b, e), and
+     * two vertices are adjacent if their nodes are neighbors. The
+     * edges are the same as those of an AdjacencyList built from
+     * the same nodes, and so are their weights given a link
+     * quality constraint q.
+     */
+    template <class C>
+    template <class Itr>
+    CSRGraph<C>::CSRGraph(Itr b, Itr e, build_mode m, const quality_type& q)
+    : _nodes(), _offsets(1, 0), _neighbors(), _weights() {
+        for (Itr itr = b; itr != e; ++itr)
+            _nodes.push_back(*itr);
+        check_size();
+        discover_neighbors<C>(b, e, m, q,
+            [&](size_type i, const std::vector<size_type>& neis) {
+                for (auto &j : neis) {
+                    _neighbors.push_back(static_cast<index_type>(j));
+                    if (q >= 0.0)
+                        _weights.push_back(link_cost(*_nodes[i], *_nodes[j]));
+                }
+                check_size();
+                _offsets.push_back(static_cast<index_type>(_neighbors.size()));
+            });
+    }
+
+    /* @fn CSRGraph()
+     *
+     * Convert an adjacency list into the CSR format. Edge weights
+     * are kept only if some edge has a weight other than the
+     * default one.
+     */
+    template <class C>
+    CSRGraph<C>::CSRGraph(const AdjacencyList<C>& al)
+    : _nodes(), _offsets(1, 0), _neighbors(), _weights() {
+        bool    weighted = false;
+
+        for (auto &v : al) {
+            _nodes.push_back(v.node());
+            for (auto &e : v.neighbors()) {
+                _neighbors.push_back(static_cast<index_type>(e.tail()->id()));
+                _weights.push_back(e.weight());
+                if (e.weight() != Edge<C>::DEFAULT_WEIGHT)
+                    weighted = true;
+            }
+            check_size();
+            _offsets.push_back(static_cast<index_type>(_neighbors.size()));
+        }
+        if (!weighted)
+            std::vector<weight_type>().swap(_weights);
+    }
+
+    template <class C>
+    void
+    CSRGraph<C>::check_size() const {
+        if (_nodes.size() >= UINT32_MAX || _neighbors.size() >= UINT32_MAX)
+            throw std::length_error("Graph is too large for 32-bit indices.");
+    }
+
+    /* @fn for_each_neighbor()
+     *
+     * Apply f(j, w) to the index j and the edge weight w of each
+     * neighbor of the v-th vertex of a graph.
+     */
+    template <class C, class F>
+    void
+    for_each_neighbor(const CSRGraph<C>& g, size_type v, F f) {
+        for (size_type k = g.offset(v); k < g.offset(v + 1); ++k)
+            f(static_cast<size_type>(g.neighbor(k)), g.weight(k));
+    }
+
+    template <class C>
+    std::ostream&
+    operator<<(std::ostream& os, const CSRGraph<C>& g) {
+        for (size_type i = 0; i < g.size(); ++i) {
+            os << "vertex: " << *g.node(i) << std::endl;
+            if (g.degree(i) != 0) {
+                os << "edges: ";
+                for (auto itr = g.begin(i); itr != g.end(i); ++itr)
+                    os << "[" << i << "-->" << *itr << "] ";
+                os << std::endl;
+            } else {
+                os << "isolated" << std::endl;
+            }
+            os << std::endl;
+        }
+        return os;
+    }
+}
+
+#endif
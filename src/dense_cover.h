@@ -0,0 +1,398 @@
+#ifndef QOSRNP_DENSE_COVER_H
+#define QOSRNP_DENSE_COVER_H
+
+#include <set>
+#include <vector>
+#include <initializer_list>
+#include <random>
+#include <stdexcept>
+#include <cstdint>      // uint32_t
+
+#include "header.h"
+#include "bitset.h"
+#include "miscellaneous.h"
+#include "sampling.h"
+
+namespace qosrnp {
+    // type declarations.
+    class DenseCover;
+
+    /* @class DenseCover
+     *
+     * Cover<size_type, size_type> whose keys and elements are
+     * integers in [0, n), e.g., indices of nodes. Each set of the
+     * family and the set to cover are bitsets of n bits, so a set
+     * takes n / 8 bytes rather than a tree node per element, sizes
+     * are popcounts, and covered elements are removed from a set by
+     * word-wise and-not. The covers found are the same as those
+     * Cover finds, ties and random draws included.
+     */
+    class DenseCover {
+    public:
+        typedef size_type        key_type;
+        typedef size_type        value_type;
+
+        DenseCover() : _n(0), _family(), _keys(), _set() {}
+        explicit DenseCover(size_type n)
+        : _n(n), _family(n), _keys(n), _set(n) {}
+        DenseCover(const DenseCover&) = default;
+        DenseCover(DenseCover&&) = default;
+        ~DenseCover() = default;
+
+        DenseCover& operator=(const DenseCover&) = default;
+        DenseCover& operator=(DenseCover&&) = default;
+
+        // number of possible keys and elements.
+        size_type size() const { return _n; }
+
+        // insert a list of elements to the _set field.
+        void insert_set(const std::initializer_list<value_type>&);
+        // insert an element into the _set field.
+        void insert_set(const value_type&);
+        void insert_set(const DynamicBitset&);
+        // insert elements into the set of the _family field with given key.
+        void insert_family(const key_type&, const DynamicBitset&);
+        void insert_family(const key_type&, const std::initializer_list<value_type>&);
+        void insert_family(const key_type&, const value_type&);
+
+        // whether the _family field has a set with given key.
+        bool has_family(const key_type& key) const { return key < _n && _keys.test(key); }
+        const DynamicBitset& family(const key_type&) const;
+        const DynamicBitset& set() const { return _set; }
+
+        // search a minimum set cover of _set field using _family field,
+        // using the greedy algorithm.
+        std::set<key_type> minimum_set_cover() const;
+        // search a minimum k-set cover of _set field using _family field,
+        // using the greedy algorithm.
+        std::set<key_type> k_set_cover(const size_type&);
+        // search a random k-set cover of _set field using _family field,
+        // using roulette wheel method, or return an empty set if none
+        // is found.
+        std::set<key_type> random_k_set_cover(std::default_random_engine&, const size_type&);
+
+    private:
+        // working copy of the family while searching a cover.
+        struct Working {
+            std::vector<DynamicBitset>    sets;
+            DynamicBitset                 keys;
+            // number of sets covering each element.
+            std::vector<uint32_t>         cnt;
+            // size of the set of each key.
+            FenwickTree<size_type>        sizes;
+        };
+
+        void check_range(size_type) const;
+        DynamicBitset& family_of(const key_type&);
+        Working working() const;
+        // return the key of the set with maximal size from given family.
+        key_type max_set(const Working&) const;
+        // return the key of a random set selected using the roulette wheel method.
+        key_type random_set(std::default_random_engine&, const Working&) const;
+        // split the set with given key into the elements only covered by
+        // it and the others.
+        bool split(const Working&, const key_type&, const size_type&,
+                   DynamicBitset&, DynamicBitset&) const;
+        // make a k cover, keeping the smallest optional elements.
+        bool make_k_cover(Working&, const key_type&, const size_type&) const;
+        bool make_random_k_cover(std::default_random_engine&, Working&,
+                                 const key_type&, const size_type&) const;
+        // remove the picked set from w, and its elements from the other
+        // sets of w and _family.
+        void pick(Working&, const key_type&, DynamicBitset&);
+
+    private:
+        size_type                     _n;
+        // set of each key, empty unless _keys has the key.
+        std::vector<DynamicBitset>    _family;
+        DynamicBitset                 _keys;
+        DynamicBitset                 _set;
+    };
+
+    void
+    DenseCover::check_range(size_type i) const {
+        if (i >= _n)
+            throw std::range_error("Key or element out of range.");
+    }
+
+    DynamicBitset&
+    DenseCover::family_of(const key_type& key) {
+        check_range(key);
+        if (!_keys.test_and_set(key))
+            _family[key].resize(_n);
+        return _family[key];
+    }
+
+    const DynamicBitset&
+    DenseCover::family(const key_type& key) const {
+        if (!has_family(key))
+            throw std::range_error("No set with given key.");
+        return _family[key];
+    }
+
+    void
+    DenseCover::insert_set(const std::initializer_list<value_type>& il) {
+        for (auto &i : il)
+            insert_set(i);
+    }
+
+    void
+    DenseCover::insert_set(const value_type& val) {
+        check_range(val);
+        _set.set(val);
+    }
+
+    void
+    DenseCover::insert_set(const DynamicBitset& s) {
+        if (s.size() != _n)
+            throw std::range_error("Set of a different size.");
+        _set |= s;
+    }
+
+    void
+    DenseCover::insert_family(const key_type& key, const DynamicBitset& s) {
+        if (s.size() != _n)
+            throw std::range_error("Set of a different size.");
+        family_of(key) |= s;
+    }
+
+    void
+    DenseCover::insert_family(const key_type& key,
+                              const std::initializer_list<value_type>& il) {
+        for (auto &i : il)
+            insert_family(key, i);
+    }
+
+    void
+    DenseCover::insert_family(const key_type& key, const value_type& val) {
+        check_range(val);
+        family_of(key).set(val);
+    }
+
+    /* @fn minimum_set_cover()
+     *
+     * The lazy greedy search of Cover::minimum_set_cover(), where a
+     * set is recounted by a popcount of its elements not covered yet.
+     */
+    std::set<DenseCover::key_type>
+    DenseCover::minimum_set_cover() const {
+        std::set<key_type>                 mi;
+        DynamicBitset                      tmp_s = _set, covered(_n);
+        // keys of the sets by their last counted sizes.
+        std::vector<std::set<key_type>>    buckets(1);
+        size_type                          top, cnt;
+
+        for (size_type k = _keys.find_first(); k != DynamicBitset::NPOS;
+             k = _keys.find_next(k)) {
+            cnt = _family[k].count();
+            if (cnt >= buckets.size())
+                buckets.resize(cnt + 1);
+            buckets[cnt].insert(k);
+        }
+        top = buckets.size() - 1;
+        while (tmp_s.any()) {
+            while (top > 0 && buckets[top].empty())
+                --top;
+            // no remaining set covers anything new.
+            if (top == 0) {
+                mi.clear();
+                return mi;
+            }
+            key_type k = *buckets[top].begin();
+            buckets[top].erase(buckets[top].begin());
+            cnt = _family[k].count_subtract(covered);
+            if (cnt < top) {
+                buckets[cnt].insert(k);
+                continue;
+            }
+            covered |= _family[k];
+            tmp_s.subtract(_family[k]);
+            mi.insert(k);
+        }
+        return mi;
+    }
+
+    DenseCover::Working
+    DenseCover::working() const {
+        Working    w;
+
+        w.sets = _family;
+        w.keys = _keys;
+        w.cnt.assign(_n, 0);
+        w.sizes = FenwickTree<size_type>(_n);
+        for (size_type k = _keys.find_first(); k != DynamicBitset::NPOS;
+             k = _keys.find_next(k)) {
+            w.sizes.set(k, _family[k].count());
+            for (size_type e = _family[k].find_first(); e != DynamicBitset::NPOS;
+                 e = _family[k].find_next(e))
+                ++w.cnt[e];
+        }
+        return w;
+    }
+
+    DenseCover::key_type
+    DenseCover::max_set(const Working& w) const {
+        key_type     m = w.keys.find_first();
+
+        for (size_type k = w.keys.find_next(m); k != DynamicBitset::NPOS;
+             k = w.keys.find_next(k))
+            if (w.sizes.weight(k) > w.sizes.weight(m))
+                m = k;
+        return m;
+    }
+
+    /* @fn random_set()
+     *
+     * Draw a set with a probability proportional to its size, the
+     * same way Cover::random_set() does for the same engine. Some
+     * set of w must be non-empty.
+     */
+    DenseCover::key_type
+    DenseCover::random_set(std::default_random_engine& en, const Working& w) const {
+        size_type size = w.sizes.total();
+
+        std::uniform_int_distribution<int> dis(0, size);
+        size_type    r = dis(en);
+
+        // the first set reaching 0 may be empty, reaching 1 may not.
+        return w.sizes.lower_bound(r == 0 ? 1 : r);
+    }
+
+    bool
+    DenseCover::split(const Working& w, const key_type& key, const size_type& k,
+                      DynamicBitset& nec, DynamicBitset& opt) const {
+        nec.resize(_n);
+        nec.clear();
+        opt = w.sets[key];
+        for (size_type e = opt.find_first(); e != DynamicBitset::NPOS;
+             e = opt.find_next(e))
+            if (w.cnt[e] == 1)
+                nec.set(e);
+        opt.subtract(nec);
+        return nec.count() <= k;
+    }
+
+    bool
+    DenseCover::make_k_cover(Working& w, const key_type& key, const size_type& k) const {
+        DynamicBitset    nec, opt;
+        size_type        cnt;
+
+        if (!split(w, key, k, nec, opt))
+            return false;
+        cnt = nec.count();
+        for (size_type e = opt.find_first(); e != DynamicBitset::NPOS;
+             e = opt.find_next(e))
+            if (cnt < k)
+                ++cnt;
+            else {
+                w.sets[key].reset(e);
+                --w.cnt[e];
+            }
+        return true;
+    }
+
+    bool
+    DenseCover::make_random_k_cover(std::default_random_engine& en, Working& w,
+                                    const key_type& key, const size_type& k) const {
+        DynamicBitset    nec, opt;
+        size_type        cnt, left;
+
+        if (!split(w, key, k, nec, opt))
+            return false;
+        cnt = nec.count();
+        left = opt.count();
+        w.sets[key] = nec;
+        while (cnt < k && left) {
+            size_type e = opt.find_nth(rand_range(en, 0, static_cast<int>(left) - 1));
+            w.sets[key].set(e);
+            opt.reset(e);
+            ++cnt;
+            --left;
+        }
+        for (size_type e = opt.find_first(); e != DynamicBitset::NPOS;
+             e = opt.find_next(e))
+            --w.cnt[e];
+        return true;
+    }
+
+    void
+    DenseCover::pick(Working& w, const key_type& m, DynamicBitset& tmp_s) {
+        const DynamicBitset&    s = w.sets[m];
+
+        for (size_type k = _keys.find_first(); k != DynamicBitset::NPOS;
+             k = _keys.find_next(k))
+            if (k != m)
+                _family[k].subtract(s);
+        tmp_s.subtract(s);
+        // delete each covered element from remaining cover sets.
+        for (size_type k = w.keys.find_first(); k != DynamicBitset::NPOS;
+             k = w.keys.find_next(k))
+            if (k != m && w.sizes.weight(k))
+                w.sizes.set(k, w.sets[k].subtract(s).count());
+        for (size_type e = s.find_first(); e != DynamicBitset::NPOS;
+             e = s.find_next(e))
+            w.cnt[e] = 0;
+        w.sizes.set(m, 0);
+        w.keys.reset(m);
+    }
+
+    std::set<DenseCover::key_type>
+    DenseCover::k_set_cover(const size_type& k) {
+        std::set<key_type>    mi;
+        DynamicBitset         tmp_s = _set;
+        Working               w = working();
+        key_type              m;
+
+        while (tmp_s.any()) {
+            if (!w.keys.any()) {
+                mi.clear();
+                return mi;
+            }
+            m = max_set(w);
+            // make this set covers no more k elements, or there is
+            // no feasible solution to this instance.
+            if (!make_k_cover(w, m, k)) {
+                mi.clear();
+                return mi;
+            }
+            pick(w, m, tmp_s);
+            mi.insert(m);
+        }
+        return mi;
+    }
+
+    std::set<DenseCover::key_type>
+    DenseCover::random_k_set_cover(std::default_random_engine& en,
+                                   const size_type& k) {
+        std::set<key_type>    mi;
+        DynamicBitset         tmp_s = _set;
+        Working               w = working();
+        key_type              m;
+
+        while (tmp_s.any()) {
+            // no set covers anything left.
+            if (w.sizes.total() == 0) {
+                mi.clear();
+                return mi;
+            }
+            m = random_set(en, w);
+            // make this set covers no more k elements, or there is
+            // no feasible solution to this instance.
+            if (!make_random_k_cover(en, w, m, k)) {
+                mi.clear();
+                return mi;
+            }
+            pick(w, m, tmp_s);
+            mi.insert(m);
+            // if the whole family cannot guarantee a fully set cover,
+            // return an empty set.
+            if (!w.keys.any() && tmp_s.any()) {
+                mi.clear();
+                return mi;
+            }
+        }
+        return mi;
+    }
+}
+
+#endif
@@ -7,192 +7,595 @@
 #include <set>
 #include <random>
 #include <cstdlib>
+#include <chrono>
+#include <limits>
+#include <algorithm>    // max()
+#include <cstdint>      // uint8_t
 
 #include "header.h"
 #include "node.h"
 #include "graph.h"
 #include "graph_misc.h"
-#include "cover.h"
+#include "bitset.h"
+#include "sampling.h"
+#include "population.h"
+#include "memo_cache.h"
+#include "parallel.h"
+#include "context.h"
+#include "problem.h"
+#include "result.h"
 #include "dc1np.h"
 #include "rdc1np.h"
 
 namespace qosrnp {
+    // type declarations.
+    struct GAOptions;
+    enum class stop_reason: uint8_t;
+    struct GAResult;
+    class Evolution;
+
     // function predeclarations.
-    void update_optimal(std::set<size_type>&, std::vector<std::set<size_type>>&);
-    void calculate_fitness(std::vector<std::set<size_type>>&, std::vector<unsigned>&);
-    size_type fitness(const std::set<size_type>&);
-    size_type random_chromosome(std::default_random_engine&, std::vector<unsigned>&);
-    void make_cross_poll(std::vector<Node*>&, const std::set<size_type>&, 
-                         const std::set<size_type>&);
-    bool is_in_set(const size_type&, const std::set<size_type>&);
-    double average_hop(const std::vector<Node*>&, const std::set<size_type>&);
+    GAResult gqrnp(std::default_random_engine&, const std::vector<Node*>&,
+                   const GAOptions&);
+    std::set<size_type> gqrnp(std::default_random_engine&, const std::vector<Node*>&,
+                              unsigned = 1);
+    Problem ga_problem(const std::vector<Node*>&);
+    bool ga_certificate(const Problem&, GAResult&, bool);
+    Result<DynamicBitset> make_chromosome(std::default_random_engine&, const Problem&,
+                                          bool, const DynamicBitset*, size_type);
+    void update_optimal(DynamicBitset&, const Population&);
+    void calculate_fitness(const Population&, AliasTable&, size_type = CDL_NUM);
+    size_type fitness(size_type, size_type = CDL_NUM);
+    size_type random_chromosome(std::default_random_engine&, const AliasTable&);
+    void make_cross_poll(const Problem&, DynamicBitset&, const DynamicBitset&);
+    double average_hop(const Problem&, const DynamicBitset&);
+    double average_hop(const Problem&, const DynamicBitset&, MemoCache<double>&);
+    std::ostream& operator<<(std::ostream&, const stop_reason&);
+
+    /* @struct GAOptions
+     *
+     * Parameters of a gqrnp run, defaulting to the macros of
+     * header.h. A run stops after the given number of generations,
+     * or earlier on any stop condition that is set, i.e., nonzero.
+     */
+    struct GAOptions {
+        GAOptions()
+        : generations(GENERATION), population(POPULATION), candidates(0),
+          threads(1), stall_generations(0), time_budget(0.0), target_size(0),
+          cache_size(4096), max_retries(100), verbose(true) {}
+
+        size_type    generations;
+        // number of children of a generation, a positive even number.
+        size_type    population;
+        // fitness of a chromosome is candidates minus its relays, and
+        // candidates are the relays of the instance if 0.
+        size_type    candidates;
+        unsigned     threads;
+        // stop once the optimal solution has not improved for this
+        // many generations.
+        size_type    stall_generations;
+        // stop once this many seconds have passed.
+        double       time_budget;
+        // stop once the optimal solution places no more relays.
+        size_type    target_size;
+        // number of dc1np children cached.
+        size_type    cache_size;
+        // solves tried in a row for a chromosome before the run gives
+        // up. dc1np gives the same child every time, so it is tried
+        // once, and rdc1np is tried in its place after it fails.
+        size_type    max_retries;
+        // print the optimal solution of each generation.
+        bool         verbose;
+    };
+
+    /* @enum stop_reason
+     *
+     * Why a gqrnp run stopped.
+     */
+    enum class stop_reason: uint8_t {
+        GENERATIONS,
+        STALLED,
+        TIME_BUDGET,
+        TARGET_SIZE,
+        // the sensors alone meet the hop constraints.
+        NO_RELAY_NEEDED,
+        // some sensors cannot meet them with every relay on.
+        INFEASIBLE,
+        // a chromosome was not made within the retries allowed.
+        RETRIES
+    };
+
+    std::ostream&
+    operator<<(std::ostream& os, const stop_reason& r) {
+        switch (r) {
+        case stop_reason::GENERATIONS:
+            os << "generations";
+            break;
+        case stop_reason::STALLED:
+            os << "stalled";
+            break;
+        case stop_reason::TIME_BUDGET:
+            os << "time budget";
+            break;
+        case stop_reason::TARGET_SIZE:
+            os << "target size";
+            break;
+        case stop_reason::NO_RELAY_NEEDED:
+            os << "no relay needed";
+            break;
+        case stop_reason::INFEASIBLE:
+            os << "infeasible";
+            break;
+        case stop_reason::RETRIES:
+            os << "retries exhausted";
+            break;
+        }
+        return os;
+    }
+
+    /* @struct GAResult
+     *
+     * The best solution of a gqrnp run, why the run stopped, the
+     * generations it ran and the seconds it took. If the instance is
+     * infeasible, the sensors that cannot meet their hop constraints
+     * are given in late, and no relay is placed.
+     */
+    struct GAResult {
+        GAResult()
+        : relays(), reason(stop_reason::GENERATIONS), generations(0),
+          seconds(0.0), late() {}
+
+        std::set<size_type>       relays;
+        stop_reason               reason;
+        size_type                 generations;
+        double                    seconds;
+        std::vector<size_type>    late;
+    };
+
+    /* @class Evolution
+     *
+     * The population of a GA on a prepared problem, bred one
+     * generation at a time. The chromosomes of the initial population
+     * and the children of each generation are built by up to the
+     * given number of threads. Each child draws from its own engine,
+     * seeded from the engine of the run in the order of the children,
+     * so a run gives the same result for the same seed whatever the
+     * number of threads. A chromosome is the bitset of the relays it
+     * places, indexed by node id. The children dc1np makes only
+     * depend on their pools, so they are cached by pool, as are the
+     * average hops of the optimal solutions. A pool dc1np fails on
+     * keeps the rdc1np child made in its place.
+     */
+    class Evolution {
+    public:
+        Evolution(const Problem&, const GAOptions&);
+        Evolution(const Evolution&) = delete;
+        Evolution& operator=(const Evolution&) = delete;
+
+        // build the initial population, or return why a chromosome
+        // could not be made.
+        solve_status seed(std::default_random_engine&);
+        // breed the next generation, or return why a child could not
+        // be made, keeping the population as it was.
+        solve_status breed(std::default_random_engine&);
+        // add a chromosome bred elsewhere, e.g., on another island,
+        // to the population in place of one placing the most relays.
+        void immigrate(const DynamicBitset&);
+
+        const Population& population() const { return _population; }
+        const DynamicBitset& optimal() const { return _optimal; }
+        double average_hop() { return qosrnp::average_hop(_pb, _optimal, _hop_cache); }
+        const MemoCache<DynamicBitset>& cache() const { return _greedy_cache; }
+
+    private:
+        void made(size_type, const Result<DynamicBitset>&);
+        // the first failure of making the children, or OK.
+        solve_status failure() const;
+
+    private:
+        const Problem&                   _pb;
+        GAOptions                        _opts;
+        Population                       _population, _mediate, _children;
+        std::vector<unsigned>            _seeds;
+        AliasTable                       _roulette_wheel;
+        DynamicBitset                    _optimal;
+        std::vector<DynamicBitset>       _pools;
+        // the child with the same pool as each dc1np child, i.e., the
+        // child itself, an earlier one, or the population size if cached.
+        std::vector<size_type>           _twins;
+        // outcome of making each child.
+        std::vector<solve_status>        _made;
+        MemoCache<DynamicBitset>         _greedy_cache;
+        MemoCache<double>                _hop_cache;
+    };
+
+    Evolution::Evolution(const Problem& pb, const GAOptions& opts)
+    : _pb(pb), _opts(opts), _population(pb.size()), _mediate(pb.size()),
+      _children(pb.size(), opts.population),
+      _seeds(opts.population), _roulette_wheel(), _optimal(pb.size()),
+      _pools(opts.population), _twins(opts.population),
+      _made(opts.population), _greedy_cache(opts.cache_size), _hop_cache(64) {
+        if (opts.population == 0 || opts.population % 2)
+            throw std::range_error("Population must be a positive even number.");
+        if (_opts.candidates == 0)
+            _opts.candidates = pb.size() - pb.sinks().size() - pb.sensors().size();
+    }
+
+    /* @fn made()
+     *
+     * Put a chromosome made for the i-th child in place, if any, and
+     * record the outcome.
+     */
+    void
+    Evolution::made(size_type i, const Result<DynamicBitset>& ch) {
+        _made[i] = ch.status();
+        if (ch)
+            _children.set(i, ch.value());
+    }
+
+    solve_status
+    Evolution::failure() const {
+        for (auto &s : _made)
+            if (s != solve_status::OK)
+                return s;
+        return solve_status::OK;
+    }
+
+    solve_status
+    Evolution::seed(std::default_random_engine& en) {
+        for (auto &s : _seeds)
+            s = en();
+        parallel_for(_opts.population, _opts.threads, [&](size_type i) {
+            std::default_random_engine    cen(_seeds[i]);
+            made(i, make_chromosome(cen, _pb, i == 0, nullptr, _opts.max_retries));
+        });
+        if (failure() != solve_status::OK)
+            return failure();
+        _population = _children;
+        update_optimal(_optimal, _population);
+        return solve_status::OK;
+    }
+
+    solve_status
+    Evolution::breed(std::default_random_engine& en) {
+        const size_type    n = _opts.population;
+
+        // calculate the fitness of each chromosome, and build
+        // the roulette wheel based on the fitness calculation.
+        calculate_fitness(_population, _roulette_wheel, _opts.candidates);
+        // selection process.
+        // select n chromosomes from the last generation
+        // using the random roulette wheel method.
+        for (size_type j = 0; j < n; ++j)
+            _mediate.push_back(_population, random_chromosome(en, _roulette_wheel));
+
+        // crossover process.
+        // the j-th pair of parents gives the 2j-th child by dc1np
+        // and the (2j+1)-th child by rdc1np, on the union of the
+        // parents. A dc1np child is taken from the cache, or from
+        // the first child of this generation with the same pool.
+        for (auto &s : _seeds)
+            s = en();
+        for (size_type c = 0; c < n; c += 2) {
+            _pools[c] = DynamicBitset(_pb.size());
+            _mediate.unite(c, _pools[c]);
+            _mediate.unite(c + 1, _pools[c]);
+            _twins[c] = c;
+            if (const DynamicBitset* ch = _greedy_cache.find(_pools[c])) {
+                _children.set(c, *ch);
+                _twins[c] = n;
+            } else
+                for (size_type t = 0; t < c; t += 2)
+                    if (_twins[t] == t && _pools[t] == _pools[c]) {
+                        _twins[c] = t;
+                        break;
+                    }
+        }
+        parallel_for(n, _opts.threads, [&](size_type c) {
+            std::default_random_engine    cen(_seeds[c]);
+            size_type                     j = c - c % 2;
+            _made[c] = solve_status::OK;
+            if (c % 2 == 0 && _twins[c] != c)
+                return;
+            made(c, make_chromosome(cen, _pb, c % 2 == 0, &_pools[j],
+                                    _opts.max_retries));
+        });
+        if (failure() != solve_status::OK) {
+            _mediate.clear();
+            return failure();
+        }
+        for (size_type c = 0; c < n; c += 2)
+            if (_twins[c] == c)
+                _greedy_cache.insert(_pools[c], _children.chromosome(c));
+            else if (_twins[c] < n)
+                _children.set(c, _children.chromosome(_twins[c]));
+        // the children replace their parents, so the population keeps
+        // its size.
+        _population = _children;
+        _mediate.clear();
+        // update optimal solution.
+        update_optimal(_optimal, _population);
+        return solve_status::OK;
+    }
+
+    void
+    Evolution::immigrate(const DynamicBitset& ch) {
+        size_type    worst = 0;
+
+        for (size_type i = 1; i < _population.size(); ++i)
+            if (_population.count(i) > _population.count(worst))
+                worst = i;
+        _population.set(worst, ch);
+        if (_optimal.count() == 0 || ch.count() < _optimal.count())
+            _optimal = ch;
+    }
 
     /* @fn gqrnp()
      *
      * The Genetic-algorithm based QoS constrained Relay Node Placement 
-     * (GQRNP) algorithm.
+     * (GQRNP) algorithm, run with given options. The instance is
+     * prepared once, so a child only fills the mask of its crossover
+     * pool. The run stops after opts.generations generations, or as
+     * soon as a stop condition of opts holds, and returns the best
+     * solution found so far.
      */
-    std::set<size_type>
-    gqrnp(std::default_random_engine& en, const std::vector<Node*>& nds) {
-        std::vector<std::set<size_type>>       population, mediate, current;
-        std::vector<unsigned>                  roulette_wheel;
-        std::set<size_type>                    tmp, optimal;
-
-        // generate initial population.
-        for (int i = 0; i < POPULATION; ) {
-            try {
-                for (auto &n : nds) {
-                    n->set_power(qosrnp::power);
-                    if (n->type() == qosrnp::node_type::SENSOR)
-                        n->set_hop(qosrnp::hop_constraint);
-                    else 
-                        n->set_hop(9999);
-                }
-                std::vector<Node*>    nodes(nds.begin(), nds.end());
-                if (i == 0)
-                    tmp = dc1np(nodes);
-                else
-                    tmp = rdc1np(en, nodes);
-            } catch (std::range_error e) {
-                continue;
+    GAResult
+    gqrnp(std::default_random_engine& en, const std::vector<Node*>& nds,
+          const GAOptions& opts) {
+        typedef std::chrono::steady_clock    clock_type;
+
+        clock_type::time_point    start = clock_type::now();
+        const Problem             pb = ga_problem(nds);
+        Evolution                 evo(pb, opts);
+        GAResult                  res;
+        size_type                 best, stalled = 0;
+        auto                      seconds = [&]() {
+            return std::chrono::duration<double>(clock_type::now() - start).count();
+        };
+        auto                      report = [&]() {
+            if (!opts.verbose)
+                return;
+            std::cout << "current optimal: " << evo.optimal().count();
+            std::cout << ", average hop: " << evo.average_hop() << std::endl;
+        };
+
+        if (!ga_certificate(pb, res, opts.verbose)) {
+            res.seconds = seconds();
+            return res;
+        }
+        if (evo.seed(en) != solve_status::OK) {
+            res.reason = stop_reason::RETRIES;
+            res.seconds = seconds();
+            return res;
+        }
+        best = evo.optimal().count();
+        report();
+
+        // reproduce
+        res.reason = stop_reason::GENERATIONS;
+        for (res.generations = 0; ; ++res.generations) {
+            if (opts.target_size && best <= opts.target_size) {
+                res.reason = stop_reason::TARGET_SIZE;
+                break;
+            }
+            if (opts.stall_generations && stalled >= opts.stall_generations) {
+                res.reason = stop_reason::STALLED;
+                break;
             }
-            if (!tmp.empty()) {
-                population.push_back(tmp);
-                ++i;
+            if (opts.time_budget > 0.0 && seconds() >= opts.time_budget) {
+                res.reason = stop_reason::TIME_BUDGET;
+                break;
             }
-            tmp.clear();
+            if (res.generations >= opts.generations)
+                break;
+            if (evo.breed(en) != solve_status::OK) {
+                res.reason = stop_reason::RETRIES;
+                break;
+            }
+            report();
+            if (evo.optimal().count() < best) {
+                best = evo.optimal().count();
+                stalled = 0;
+            } else
+                ++stalled;
         }
 
-        update_optimal(optimal, population);
-        std::cout << "current optimal: " << optimal.size();
-        std::cout << ", average hop: " << average_hop(nds, optimal) << std::endl;
+        if (opts.verbose)
+            std::cout << "cache hits: " << evo.cache().hits()
+                      << ", misses: " << evo.cache().misses() << std::endl;
+        for (size_type r = evo.optimal().find_first(); r != DynamicBitset::NPOS;
+             r = evo.optimal().find_next(r))
+            res.relays.insert(res.relays.end(), r);
+        res.seconds = seconds();
+        return res;
+    }
 
-        // reproduce
-        for (int i = 0; i < GENERATION; ++i) {
-            // calculate the fitness of each chromosome, and build
-            // the roulette wheel based on the fitness calculation.
-            calculate_fitness(population, roulette_wheel);
-            // selection process.
-            // select POPULATION chromosomes from the last generation
-            // using the random roulette wheel method.
-            for (int j = 0; j < POPULATION; ++j)
-                mediate.push_back(population[random_chromosome(en, roulette_wheel)]);
-            
-            // crossover process.
-            for (int j = 0; j < POPULATION; j += 2) {
-                for (int k = 0; k < 2; ) {
-                    try {
-                        for (auto &n : nds) {
-                            n->set_power(qosrnp::power);
-                            if (n->type() == qosrnp::node_type::SENSOR)
-                                n->set_hop(qosrnp::hop_constraint);
-                            else 
-                                n->set_hop(9999);
-                        }
-                        std::vector<Node*>      cross_poll(nds.begin(), nds.end());
-                        make_cross_poll(cross_poll, mediate[j], mediate[j + 1]);
-                        if (k == 0)
-                            tmp = dc1np(cross_poll);
-                        else
-                            tmp = rdc1np(en, cross_poll);
-                    } catch (std::range_error e) {
-                        continue;
-                    }
-                    if (!tmp.empty()) {
-                        current.push_back(tmp);
-                        ++k;
-                    }
-                    tmp.clear();
-                }
+    std::set<size_type>
+    gqrnp(std::default_random_engine& en, const std::vector<Node*>& nds,
+          unsigned threads) {
+        GAOptions    opts;
+
+        opts.threads = threads;
+        return gqrnp(en, nds, opts).relays;
+    }
+
+    /* @fn ga_problem()
+     *
+     * Prepare the instance of a GA run on given nodes, where every
+     * node has the global transmit power and the sensors have the
+     * global hop constraint, whatever the nodes have.
+     */
+    Problem
+    ga_problem(const std::vector<Node*>& nds) {
+        SolveContext    ctx(nds);
+
+        for (size_type i = 0; i < ctx.size(); ++i) {
+            ctx.set_power(i, qosrnp::power);
+            if (ctx.node(i).type() == qosrnp::node_type::SENSOR)
+                ctx.set_hop(i, qosrnp::hop_constraint);
+            else
+                ctx.set_hop(i, 9999);
+        }
+        return Problem(ctx);
+    }
+
+    /* @fn ga_certificate()
+     *
+     * Decide up front whether problem pb needs a GA run at all. No
+     * relay is needed if the sensors alone meet their hop constraints,
+     * and no placement exists if some sensors cannot meet them with
+     * every relay on, which those sensors prove.
+     * @return true if a run is needed, or false with the reason, and
+     *         the late sensors if infeasible, given in res.
+     */
+    bool
+    ga_certificate(const Problem& pb, GAResult& res, bool verbose) {
+        if (pb.sensors_suffice()) {
+            res.reason = stop_reason::NO_RELAY_NEEDED;
+            return false;
+        }
+        if (pb.feasible())
+            return true;
+        res.reason = stop_reason::INFEASIBLE;
+        res.late = pb.late_sensors();
+        if (verbose) {
+            std::cout << "sensors beyond their hop constraints:";
+            for (auto &s : res.late)
+                std::cout << " " << s;
+            std::cout << std::endl;
+        }
+        return false;
+    }
+
+    /* @fn make_chromosome()
+     *
+     * Solve problem pb, by dc1np if greedy or rdc1np otherwise, on
+     * the crossover pool of the relays in pool if it is given, until
+     * a placement of some relays is found, trying at most retries
+     * times. dc1np gives the same placement on the same pool every
+     * time, so it is tried once, and rdc1np is tried after it fails,
+     * e.g., when its greedy choices miss a placement the pool has.
+     * It works on its own mask and never changes the problem, so
+     * chromosomes of the same deployment can be made at the same
+     * time.
+     * @return the chromosome, or why the last try found none.
+     */
+    Result<DynamicBitset>
+    make_chromosome(std::default_random_engine& en, const Problem& pb,
+                    bool greedy, const DynamicBitset* pool, size_type retries) {
+        DynamicBitset                  cross_poll = pb.mask(), ch(pb.size());
+        Result<std::set<size_type>>    tmp = solve_status::NO_COVER;
+
+        if (pool != nullptr)
+            make_cross_poll(pb, cross_poll, *pool);
+        for (size_type t = 0; t < std::max(retries, size_type(1)); ++t) {
+            tmp = greedy && t == 0 ? dc1np(pb, cross_poll) : rdc1np(en, pb, cross_poll);
+            if (tmp && !tmp.value().empty()) {
+                for (auto &r : tmp.value())
+                    ch.set(r);
+                return ch;
             }
-            roulette_wheel.clear();
-            population.clear();
-            mediate.clear();
-            population = current;
-            // update optimal solution.
-            update_optimal(optimal, population);
-            std::cout << "current optimal: " << optimal.size();
-            std::cout << ", average hop: " << average_hop(nds, optimal) << std::endl;
         }
-        return optimal;
+        return tmp ? solve_status::NO_COVER : tmp.status();
     }
 
     void
-    update_optimal(std::set<size_type>& op, std::vector<std::set<size_type>>& popu) {
-        for (auto &ch : popu)
-            if (op.size() == 0)
-                op = ch;
-            else if (ch.size() < op.size()) {
-                op.clear();
-                op = ch;
+    update_optimal(DynamicBitset& op, const Population& popu) {
+        size_type    best = op.count();
+
+        for (size_type i = 0; i < popu.size(); ++i)
+            if (best == 0 || popu.count(i) < best) {
+                op = popu.chromosome(i);
+                best = popu.count(i);
             }
     }
 
+    /* @fn calculate_fitness()
+     *
+     * Build the roulette wheel of a population, i.e., an alias table
+     * of the fitness of its chromosomes, or of even chances if none
+     * of them is fit.
+     */
     void
-    calculate_fitness(std::vector<std::set<size_type>>& po, std::vector<unsigned>& rw) {
-        for (int i = 0; i < po.size(); ++i)
-            if (i == 0)
-                rw.push_back(fitness(po[i]));
-            else
-                rw.push_back(rw[i - 1] + fitness(po[i]));
+    calculate_fitness(const Population& po, AliasTable& rw, size_type candidates) {
+        std::vector<double>    fit;
+        double                 sum = 0.0;
+
+        for (size_type i = 0; i < po.size(); ++i) {
+            fit.push_back(fitness(po.count(i), candidates));
+            sum += fit.back();
+        }
+        if (sum <= 0.0)
+            fit.assign(po.size(), 1.0);
+        rw = AliasTable(fit);
     }
 
+    /* @fn fitness()
+     *
+     * Fitness of a chromosome placing given number of relays out of
+     * given number of candidates, or 0 if it places more.
+     */
     size_type
-    fitness(const std::set<size_type>& ch) {
-        return CDL_NUM - ch.size();
+    fitness(size_type relays, size_type candidates) {
+        return relays < candidates ? candidates - relays : 0;
     }
 
+    /* @fn random_chromosome()
+     *
+     * Select a chromosome with a probability proportional to its
+     * fitness, in O(1) time.
+     */
     size_type
-    random_chromosome(std::default_random_engine& e, std::vector<unsigned>& rw) {
-        std::uniform_int_distribution<unsigned>  u(0, rw.back());
-        unsigned                                 r = u(e);
-
-        for (int i = 0; i < rw.size(); ++i)
-            if (r <= rw[i])
-                return i;
+    random_chromosome(std::default_random_engine& e, const AliasTable& rw) {
+        return rw(e);
     }
 
+    /* @fn make_cross_poll()
+     *
+     * Switch off the relays of problem pb not in pool, in mask cp,
+     * i.e., keep the sinks, the sensors and the pool.
+     */
     void
-    make_cross_poll(std::vector<Node*>& cp, const std::set<size_type>& p1, 
-                    const std::set<size_type>& p2) {
-        std::set<size_type>    pp;
-
-        for (auto &n : cp)
-            if ((n->type() != node_type::SINK) && 
-                (n->type() != node_type::SENSOR) &&
-                !(is_in_set(n->id(), p1) || is_in_set(n->id(), p2))) {
-                n->set_power(0.0);
-            }
+    make_cross_poll(const Problem& pb, DynamicBitset& cp, const DynamicBitset& pool) {
+        DynamicBitset    keep = pool;
+
+        for (auto &s : pb.sinks())
+            keep.set(s);
+        for (auto &s : pb.sensors())
+            keep.set(s);
+        cp &= keep;
     }
 
-    bool
-    is_in_set(const size_type& n, const std::set<size_type>& s) {
-        for (auto &e : s)
-            if (n == e)
-                return true;
-        return false;
+    /* @fn average_hop()
+     *
+     * Average hops from the sensors to their nearest sinks when the
+     * relays switched on are those in rns, taken from cache if it
+     * has them.
+     */
+    double
+    average_hop(const Problem& pb, const DynamicBitset& rns,
+                MemoCache<double>& cache) {
+        if (const double* h = cache.find(rns))
+            return *h;
+
+        double    hop = average_hop(pb, rns);
+        cache.insert(rns, hop);
+        return hop;
     }
 
     double 
-    average_hop(const std::vector<Node*>& nds, const std::set<size_type>& rns) {
-        for (auto &n : nds) {
-            n->set_power(qosrnp::power);
-            if (n->type() == qosrnp::node_type::SENSOR)
-                n->set_hop(qosrnp::hop_constraint);
-            else 
-                n->set_hop(9999);
-        }
-        std::vector<Node*>  tmp_nds = nds;
-        make_cross_poll(tmp_nds, rns, std::set<size_type>());
-        AdjacencyList<Node> al(tmp_nds.begin(), tmp_nds.end());
-        std::vector<size_type>    dests;
-        double                 hop = 0.0;
-        for (auto &n : nds)
-            if (n->type() == node_type::SENSOR)
-                dests.push_back(n->id());
-        dijkstra_spt(al, 0, dests);
+    average_hop(const Problem& pb, const DynamicBitset& rns) {
+        DynamicBitset                    on = pb.mask();
+        make_cross_poll(pb, on, rns);
+        MaskedGraph<CSRGraph<Node>>      g = pb.view(on);
+        const std::vector<size_type>&    dests = pb.sensors();
+        double                           hop = 0.0;
+        if (!is_connected(g, pb.sinks(), dests))
+            throw std::range_error("Source cannot connect all destinations.");
+        std::vector<hop_type>            hops =
+            hop_distances(g, pb.sinks(), std::numeric_limits<hop_type>::max());
         for (auto &d : dests)
-            hop += al[d].weight();
+            hop += hops[d];
         return hop / dests.size();
     }
 }
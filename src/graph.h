@@ -9,15 +9,19 @@
 #include <stdexcept>
 #include <climits>      // INT_MAX
 #include <cfloat>       // DBL_MAX
+#include <algorithm>    // sort(), remove_if()
 
 #include "header.h"
 #include "node.h"
+#include "grid.h"
+#include "kdtree.h"
 
 namespace qosrnp {
     // type declarations.
     template <class C> class Vertex;
     template <class C> class Edge;
     template <class C> class AdjacencyList;
+    enum class build_mode: uint8_t;
 
     // function declarations.
     template <class C>
@@ -26,6 +30,10 @@ namespace qosrnp {
     std::ostream& operator<<(std::ostream&, const Vertex<C>&);
     template <class C>
     std::ostream& operator<<(std::ostream&, const AdjacencyList<C>&);
+    template <class C, class Itr, class F>
+    void discover_neighbors(Itr, Itr, build_mode, const quality_type&, F);
+    template <class C, class F>
+    void for_each_neighbor(const AdjacencyList<C>&, size_type, F);
 
 
     /* @class Edge
@@ -166,7 +174,7 @@ namespace qosrnp {
         void   set_weight(const weight_type& w) { _weight = w; }
         void   set_parent(const id_type& p) { _parent = p; }
 
-        std::vector<Edge<C>>  neighbors() const { return _neighbors; }
+        const std::vector<Edge<C>>& neighbors() const { return _neighbors; }
         std::vector<Edge<C>>& neighbors() { return _neighbors; }
         void push_neighbor(const Edge<C>& e) { _neighbors.push_back(e); }
         void pop_neighbor() { _neighbors.pop_back(); }
@@ -225,6 +233,97 @@ namespace qosrnp {
         return *this;
     }
  
+    /* @enum build_mode
+     *
+     * enumerate type for choosing how neighbors are discovered
+     * when building a graph from nodes, i.e., BRUTE_FORCE for
+     * checking every pair of nodes, GRID for checking only pairs
+     * of nodes lying in adjacent cells of a uniform grid, and
+     * KD_TREE for checking only nodes within the transmit power
+     * of each node, found by a k-d tree. KD_TREE suits sparse or
+     * very non-uniform deployments where most grid cells are empty.
+     */
+    enum class build_mode: uint8_t {
+        BRUTE_FORCE,
+        GRID,
+        KD_TREE
+    };
+
+    /* link quality constraint of a graph without link quality,
+     * i.e., a graph whose edges are all the neighbor pairs and
+     * have the default weight.
+     */
+    const quality_type    ANY_QUALITY = -1.0;
+
+    /* @fn discover_neighbors()
+     *
+     * Find the neighbors of each node in [b, e), and apply f(i, neis)
+     * to the position i of each node and the positions of its
+     * neighbors, which are sorted ascending, i.e., in the order of
+     * checking every pair, whatever build mode is used. Unless q is
+     * ANY_QUALITY, neighbors whose links have a quality lower than
+     * q are dropped on the way.
+     */
+    template <class C, class Itr, class F>
+    void
+    discover_neighbors(Itr b, Itr e, build_mode m, const quality_type& q, F f) {
+        std::vector<C*>           nodes;
+        std::vector<size_type>    neis;
+        coordinate_type           side = 0.0;
+        auto                      emit = [&](size_type i) {
+            if (q >= 0.0)
+                neis.erase(std::remove_if(neis.begin(), neis.end(),
+                               [&](size_type j) {
+                                   return link_quality(*nodes[i], *nodes[j]) < q;
+                               }), neis.end());
+            f(i, neis);
+        };
+
+        for (Itr itr = b; itr != e; ++itr) {
+            nodes.push_back(*itr);
+            if ((*itr)->power() > side)
+                side = (*itr)->power();
+        }
+        // Two nodes cannot be neighbors if their distance exceeds
+        // the maximal transmit power, so it is used as the cell side
+        // of the grid. Without positive power only coincident nodes
+        // can be neighbors, which the grid cannot bucket.
+        if (m == build_mode::GRID && side > 0.0) {
+            Grid<C>    grid(b, e, side);
+            for (size_type i = 0; i < nodes.size(); ++i) {
+                neis.clear();
+                grid.for_each_candidate(i, [&](size_type j) {
+                    if (i != j && is_neighbor(*nodes[i], *nodes[j]))
+                        neis.push_back(j);
+                });
+                std::sort(neis.begin(), neis.end());
+                emit(i);
+            }
+        } else if (m == build_mode::KD_TREE) {
+            KDTree<C>  tree(b, e);
+            for (size_type i = 0; i < nodes.size(); ++i) {
+                neis.clear();
+                // a neighbor must lie within the power of this node.
+                tree.radius(tree[i], nodes[i]->power(), neis);
+                neis.erase(std::remove_if(neis.begin(), neis.end(),
+                               [&](size_type j) {
+                                   return i == j ||
+                                          !is_neighbor(*nodes[i], *nodes[j]);
+                               }), neis.end());
+                std::sort(neis.begin(), neis.end());
+                emit(i);
+            }
+        } else {
+            for (size_type i = 0; i < nodes.size(); ++i) {
+                neis.clear();
+                for (size_type j = 0; j < nodes.size(); ++j)
+                    if (i != j && is_neighbor(*nodes[i], *nodes[j]))
+                        neis.push_back(j);
+                emit(i);
+            }
+        }
+    }
+
     /* @class AdjacencyList
      *
      * Adjacency list of an undirected graph.
@@ -240,13 +339,18 @@ namespace qosrnp {
 
         static const weight_type     INFTY;
 
-        AdjacencyList() : vertices(std::vector<Vertex<C>>()) {}
+        AdjacencyList()
+        : vertices(std::vector<Vertex<C>>()), potentials(), inactive() {}
         AdjacencyList(const AdjacencyList& al)
-        : vertices(al.vertices) {}
+        : vertices(al.vertices), potentials(al.potentials),
+          inactive(al.inactive) {}
         AdjacencyList(AdjacencyList&& al)
-        : vertices(std::move(al.vertices)) {}
+        : vertices(std::move(al.vertices)),
+          potentials(std::move(al.potentials)),
+          inactive(std::move(al.inactive)) {}
 
-        template <class Itr> AdjacencyList(Itr, Itr);
+        template <class Itr> AdjacencyList(Itr, Itr, build_mode = build_mode::GRID,
+                                           const quality_type& = ANY_QUALITY);
         
         ~AdjacencyList() = default;
 
@@ -269,38 +373,69 @@ namespace qosrnp {
         const_iterator end() const noexcept { return vertices.end(); }
 
         void push_back(const Vertex<C>& v) { vertices.push_back(v); }
-        void clear() { vertices.clear(); }
+        void clear() { vertices.clear(); potentials.clear(); inactive.clear(); }
 
         size_type size() const { return vertices.size(); }
+
+        // switch a vertex off by removing its incident edges, or
+        // switch it on again by restoring them.
+        void deactivate(size_type);
+        void reactivate(size_type);
+        bool is_active(size_type i) const {
+            return inactive.empty() || !inactive[i];
+        }
+
     private:
-        std::vector<Vertex<C>>    vertices;
+        // remove the edge from the i-th to the j-th vertex.
+        void erase_edge(size_type, size_type);
+        // insert the edge from the i-th to the j-th vertex, keeping
+        // neighbors ordered by id.
+        void insert_edge(size_type, size_type);
+
+    private:
+        std::vector<Vertex<C>>                  vertices;
+        // neighbor ids of each vertex while all vertices are active,
+        // recorded when a vertex is deactivated for the first time.
+        std::vector<std::vector<id_type>>       potentials;
+        std::vector<bool>                       inactive;
     };
 
     template <class C>
     const typename AdjacencyList<C>::weight_type
     AdjacencyList<C>::INFTY = DBL_MAX;
 
+    /* @fn AdjacencyList()
+     *
+     * Build a graph whose vertices are the nodes in [b, e), and
+     * two vertices are adjacent if their nodes are neighbors. Given
+     * a link quality constraint q, only links of quality q or
+     * better become edges, weighted by their link costs.
+     */
     template <class C>
     template <class Itr>
-    AdjacencyList<C>::AdjacencyList(Itr b, Itr e)
+    AdjacencyList<C>::AdjacencyList(Itr b, Itr e, build_mode m,
+                                    const quality_type& q)
     : vertices(std::vector<Vertex<C>>()) {
         // add vertices.
         for (Itr itr = b; itr != e; ++itr)
             vertices.push_back(Vertex<C>(*itr, vertices.size()));
         // add edges for each vertex.
-        for (size_type i = 0; i < vertices.size(); ++i)
-            for (size_type j = 0; j < vertices.size(); ++j)
-                if (i != j && is_neighbor(*vertices[i].node(), 
-                                          *vertices[j].node())) {
-                    vertices[i].push_neighbor(Edge<C>(&vertices[i],
-                                                      &vertices[j]));
-                }
+        discover_neighbors<C>(b, e, m, q,
+            [&](size_type i, const std::vector<size_type>& neis) {
+                for (auto &j : neis)
+                    vertices[i].push_neighbor(Edge<C>(&vertices[i], &vertices[j],
+                        q < 0.0 ? Edge<C>::DEFAULT_WEIGHT
+                                : link_cost(*vertices[i].node(),
+                                            *vertices[j].node())));
+            });
     }
 
     template <class C>
     AdjacencyList<C>&
     AdjacencyList<C>::operator=(const AdjacencyList& al) {
         vertices = al.vertices;
+        potentials = al.potentials;
+        inactive = al.inactive;
         return *this;
     }
 
@@ -308,9 +443,89 @@ namespace qosrnp {
     AdjacencyList<C>&
     AdjacencyList<C>::operator=(AdjacencyList&& al) {
         vertices = std::move(al.vertices);
+        potentials = std::move(al.potentials);
+        inactive = std::move(al.inactive);
         return *this;
     }
 
+    /* @fn deactivate()
+     *
+     * Switch the i-th vertex off, i.e., remove all edges incident
+     * to it, as if its node had no transmit power. The cost is
+     * linear in the degrees of the vertex and its neighbors, and
+     * no other vertex is touched.
+     */
+    template <class C>
+    void
+    AdjacencyList<C>::deactivate(size_type i) {
+        if (!is_active(i))
+            return;
+        if (inactive.empty()) {
+            inactive.assign(vertices.size(), false);
+            potentials.resize(vertices.size());
+            for (size_type k = 0; k < vertices.size(); ++k)
+                for (auto &e : vertices[k].neighbors())
+                    potentials[k].push_back(e.tail()->id());
+        }
+        for (auto &e : vertices[i].neighbors())
+            erase_edge(e.tail()->id(), i);
+        vertices[i].clear_neighbor();
+        inactive[i] = true;
+    }
+
+    /* @fn reactivate()
+     *
+     * Switch the i-th vertex on again, i.e., restore its edges to
+     * all active vertices it was adjacent to. Neighbors stay ordered
+     * by id, so the graph is the same as one built without the
+     * vertices that are still inactive.
+     */
+    template <class C>
+    void
+    AdjacencyList<C>::reactivate(size_type i) {
+        if (is_active(i))
+            return;
+        inactive[i] = false;
+        for (auto &j : potentials[i])
+            if (is_active(j)) {
+                vertices[i].push_neighbor(Edge<C>(&vertices[i], &vertices[j]));
+                insert_edge(j, i);
+            }
+    }
+
+    template <class C>
+    void
+    AdjacencyList<C>::erase_edge(size_type i, size_type j) {
+        std::vector<Edge<C>>& neis = vertices[i].neighbors();
+        for (auto itr = neis.begin(); itr != neis.end(); ++itr)
+            if (itr->tail()->id() == static_cast<id_type>(j)) {
+                neis.erase(itr);
+                return;
+            }
+    }
+
+    template <class C>
+    void
+    AdjacencyList<C>::insert_edge(size_type i, size_type j) {
+        std::vector<Edge<C>>& neis = vertices[i].neighbors();
+        auto itr = neis.begin();
+        while (itr != neis.end() && itr->tail()->id() < static_cast<id_type>(j))
+            ++itr;
+        neis.insert(itr, Edge<C>(&vertices[i], &vertices[j]));
+    }
+
+    /* @fn for_each_neighbor()
+     *
+     * Apply f(j, w) to the id j and the edge weight w of each
+     * neighbor of the v-th vertex of a graph.
+     */
+    template <class C, class F>
+    void
+    for_each_neighbor(const AdjacencyList<C>& al, size_type v, F f) {
+        for (auto &e : al[v].neighbors())
+            f(static_cast<size_type>(e.tail()->id()), e.weight());
+    }
+
     template <class C>
     std::ostream&
     operator<<(std::ostream& os, const Edge<C>& e) {
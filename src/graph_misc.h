@@ -2,34 +2,124 @@
 #define QOSRNP_GRAPH_MISC_H
 
 #include <vector>
+#include <limits>
+#include <utility>      // pair
 
 #include "header.h"
 #include "node.h"
 #include "graph.h"
+#include "csr_graph.h"
+#include "masked_graph.h"
+#include "bfs.h"
+#include "heap.h"
 #include "miscellaneous.h"
+#include "result.h"
 
 namespace qosrnp {
+    // type predeclarations.
+    template <typename W> struct PathTree;
+
     // function predeclarations.
     template <class C>
     bool is_in(const std::vector<Vertex<C>>&, const Vertex<C>&);
 
-    template <class C>
-    bool breadth_first_traverse(const AdjacencyList<C>&, bool);
+    template <class G>
+    bool breadth_first_traverse(const G&, bool, BFSWorkspace&);
+    template <class G>
+    bool breadth_first_traverse(const G&, bool);
 
+    template <class C>
+    AdjacencyList<C> breadth_first_tree(const AdjacencyList<C>&, BFSWorkspace&);
     template <class C>
     AdjacencyList<C> breadth_first_tree(const AdjacencyList<C>&);
 
-    template <class C>
-    bool is_connected(const AdjacencyList<C>&, size_type, const std::vector<size_type>&);
+    template <class G>
+    bool is_connected(const G&, size_type, const std::vector<size_type>&,
+                      BFSWorkspace&);
+    template <class G>
+    bool is_connected(const G&, size_type, const std::vector<size_type>&);
+    template <class G>
+    bool is_connected(const G&, const std::vector<size_type>&,
+                      const std::vector<size_type>&, BFSWorkspace&);
+    template <class G>
+    bool is_connected(const G&, const std::vector<size_type>&,
+                      const std::vector<size_type>&);
 
     template <class C>
     bool has_edge(const Edge<C>&, const std::vector<Edge<C>>&);
+
+    template <class G>
+    PathTree<hop_type> breadth_first_spt(const G&, size_type, BFSWorkspace&);
+    template <class G>
+    PathTree<hop_type> breadth_first_spt(const G&, size_type);
+
+    template <class G, class W>
+    PathTree<hop_type> dial_spt(const G&, size_type, W, hop_type);
+    template <class G>
+    PathTree<hop_type> dial_spt(const G&, size_type);
+
+    template <class G>
+    PathTree<double> weighted_spt(const G&, size_type, std::vector<hop_type>&,
+                                  hop_type = std::numeric_limits<hop_type>::max());
+
+    template <class C>
+    AdjacencyList<C> dijkstra_spt(AdjacencyList<C>&, size_type, std::vector<size_type>);
+
+    template <class C>
+    Result<PathTree<typename Vertex<C>::weight_type>>
+    dijkstra_spt(const CSRGraph<C>&, size_type, const std::vector<size_type>&);
     
     hop_type max_hop(const AdjacencyList<Node>&, 
                      const std::vector<size_type>&);
+    hop_type max_hop(const std::vector<size_type>&, const std::vector<hop_type>&);
 
     bool meet_hop(const AdjacencyList<Node>&, const size_type&, 
                   const std::vector<size_type>&);
+    bool meet_hop(const AdjacencyList<Node>&, const std::vector<size_type>&,
+                  const std::vector<hop_type>&);
+    bool meet_hop(const std::vector<hop_type>&, const std::vector<size_type>&,
+                  const std::vector<hop_type>&);
+
+    template <class G>
+    std::vector<hop_type> hop_distances(const G&, size_type, BFSWorkspace&);
+    template <class G>
+    std::vector<hop_type> hop_distances(const G&, size_type);
+    template <class G>
+    std::vector<hop_type> hop_distances(const G&, size_type, hop_type, BFSWorkspace&);
+    template <class G>
+    std::vector<hop_type> hop_distances(const G&, size_type, hop_type);
+    template <class G>
+    std::vector<hop_type> hop_distances(const G&, const std::vector<size_type>&,
+                                        hop_type, BFSWorkspace&);
+    template <class G>
+    std::vector<hop_type> hop_distances(const G&, const std::vector<size_type>&,
+                                        hop_type);
+
+    bool meet_hop_without(AdjacencyList<Node>&, const size_type&,
+                          const size_type&, const std::vector<size_type>&);
+    bool meet_hop_without(AdjacencyList<Node>&, const size_type&, const size_type&,
+                          const std::vector<size_type>&, const std::vector<hop_type>&);
+    template <class G>
+    bool meet_hop_without(MaskedGraph<G>&, const size_type&, const size_type&,
+                          const std::vector<size_type>&, const std::vector<hop_type>&);
+    template <class G>
+    bool meet_hop_without(MaskedGraph<G>&, const size_type&,
+                          const std::vector<size_type>&,
+                          const std::vector<size_type>&, const std::vector<hop_type>&);
+    bool meet_hop(const std::vector<hop_type>&, const std::vector<size_type>&,
+                  const std::vector<hop_type>&);
+
+    /* @struct PathTree
+     *
+     * Shortest path tree given by the distance to the source and
+     * the parent of each vertex, indexed by vertex id. Unreachable
+     * vertices keep the default weight and parent of a Vertex.
+     */
+    template <typename W>
+    struct PathTree {
+        std::vector<W>          weight;
+        std::vector<id_type>    parent;
+    };
 
     /* @fn breadth_first_traverse()
      *
@@ -39,37 +129,33 @@ namespace qosrnp {
      * @return true if this graph is connected, false if 
      * disconnected.
      */
-    template <class C>
+    template <class G>
     bool
-    breadth_first_traverse(const AdjacencyList<C>& al, bool p) {
-        std::vector<Vertex<C>> grey, temp_grey, black;
-
-        grey.push_back(al[0]);
-
-        while (!grey.empty()) {
-            while (!grey.empty()) {
-                int cnt = 0;
-                black.push_back(grey.back());
-                for (auto &e : grey.back().neighbors()) {
-                    if (!is_in(black, *e.tail()) && !is_in(grey, *e.tail()) && !is_in(temp_grey, *e.tail())) {
-                        ++cnt;
-                        temp_grey.push_back(*e.tail());
-                        if (p)
-                            std::cout << "v" << grey.back().id()
-                                      << "->" << "v" << e.tail()->id()
-                                      << "\t";
-                    }
+    breadth_first_traverse(const G& g, bool p, BFSWorkspace& ws) {
+        size_type    last = g.size();
+
+        if (g.size() == 0)
+            return true;
+        size_type cnt = breadth_first_search(g, 0,
+            [&](size_type u, size_type v) {
+                if (p) {
+                    if (u != last && last != g.size())
+                        std::cout << std::endl;
+                    std::cout << "v" << u << "->" << "v" << v << "\t";
                 }
-                if (cnt && p)
-                    std::cout << std::endl;
-                grey.pop_back();
-            }
-            grey = temp_grey;
-            temp_grey.clear();
-        }
-        if (black.size() < al.size())
-            return false;
-        return true;
+                last = u;
+                return true;
+            }, ws);
+        if (p && last != g.size())
+            std::cout << std::endl;
+        return cnt == g.size();
+    }
+
+    template <class G>
+    bool
+    breadth_first_traverse(const G& g, bool p) {
+        BFSWorkspace    ws;
+        return breadth_first_traverse(g, p, ws);
     }
 
     /* @fn breadth_first_tree()
@@ -78,33 +164,28 @@ namespace qosrnp {
      */
     template <class C>
     AdjacencyList<C>
-    breadth_first_tree(const AdjacencyList<C>& graph) {
-        std::vector<Vertex<C>> grey, temp_grey, black;
+    breadth_first_tree(const AdjacencyList<C>& graph, BFSWorkspace& ws) {
         AdjacencyList<C> al;
 
         for (auto &v : graph)
             al.push_back(Vertex<C>(v.node(), al.size()));
+        if (graph.size() == 0)
+            return al;
 
-        grey.push_back(graph[0]);
-
-        while (!grey.empty()) {
-            while (!grey.empty()) {
-                black.push_back(grey.back());
-                for (auto &e : grey.back().neighbors()) {
-                    if (!is_in(black, *e.tail()) && !is_in(grey, *e.tail()) &&
-                        !is_in(temp_grey, *e.tail())) {
-                        temp_grey.push_back(*e.tail());
-                        al[black.back().id()].push_neighbor(Edge<C>(&al[black.back().id()], &al[e.tail()->id()]));
-                    }
-                }
-                grey.pop_back();
-            }
-            grey = temp_grey;
-            temp_grey.clear();
-        }
+        breadth_first_search(graph, 0, [&](size_type u, size_type v) {
+            al[u].push_neighbor(Edge<C>(&al[u], &al[v]));
+            return true;
+        }, ws);
         return al;
     }
 
+    template <class C>
+    AdjacencyList<C>
+    breadth_first_tree(const AdjacencyList<C>& graph) {
+        BFSWorkspace    ws;
+        return breadth_first_tree(graph, ws);
+    }
+
     template <class C>
     bool
     is_in(const std::vector<Vertex<C>>& vec, const Vertex<C>& v) {
@@ -114,40 +195,57 @@ namespace qosrnp {
         return false;
     }
 
-    template <class C>
+    /* @fn is_connected()
+     *
+     * Check whether src connects all given destinations.
+     */
+    template <class G>
     bool
-    is_connected(const AdjacencyList<C>& al,
-                 size_type src,
-                 const std::vector<size_type>& dests) {
-        std::vector<Vertex<C>> grey, temp_grey, black;
-        int cnt = 0;
-        bool jump = false;
-
-        grey.push_back(al[src]);
-
-        while (!grey.empty() && !jump) {
-            while (!grey.empty() && !jump) {
-                black.push_back(grey.back());
-                for (auto &e : grey.back().neighbors()) {
-                    if (!is_in(black, *e.tail()) && !is_in(grey, *e.tail()) &&
-                        !is_in(temp_grey, *e.tail())) {
-                        temp_grey.push_back(*e.tail());
-                        if (index_of(dests.begin(), dests.end(), 
-                            e.tail()->id()) != -1) {
-                            if (++cnt == dests.size()) {
-                                jump = true; break;
-                            }
-                        }
-                    }
-                }
-                grey.pop_back();
-            }
-            grey = temp_grey;
-            temp_grey.clear();
-        }
+    is_connected(const G& g, size_type src,
+                 const std::vector<size_type>& dests, BFSWorkspace& ws) {
+        return is_connected(g, std::vector<size_type>(1, src), dests, ws);
+    }
+
+    /* @fn is_connected()
+     *
+     * Check whether each given destination is connected to one of
+     * srcs at least.
+     */
+    template <class G>
+    bool
+    is_connected(const G& g, const std::vector<size_type>& srcs,
+                 const std::vector<size_type>& dests, BFSWorkspace& ws) {
+        size_type    cnt = 0;
+        bool         jump = false;
+
+        ws.targets.resize(g.size());
+        ws.targets.clear();
+        for (auto &d : dests)
+            ws.targets.set(d);
+        breadth_first_search(g, srcs, [&](size_type, size_type v) {
+            if (ws.targets.test(v) && ++cnt == dests.size())
+                jump = true;
+            return !jump;
+        }, ws);
         return jump;
     }
 
+    template <class G>
+    bool
+    is_connected(const G& g, size_type src,
+                 const std::vector<size_type>& dests) {
+        BFSWorkspace    ws;
+        return is_connected(g, src, dests, ws);
+    }
+
+    template <class G>
+    bool
+    is_connected(const G& g, const std::vector<size_type>& srcs,
+                 const std::vector<size_type>& dests) {
+        BFSWorkspace    ws;
+        return is_connected(g, srcs, dests, ws);
+    }
+
     template <class C>
     bool
     has_edge(const Edge<C>& e, const std::vector<Edge<C>>& es) {
@@ -157,12 +255,196 @@ namespace qosrnp {
         return false;
     }
 
+    /* @fn breadth_first_spt()
+     *
+     * Build a shortest path tree, in hops, from src on graph g by
+     * a breadth first search. A vertex takes as parent the vertex
+     * it is first reached from, which is what the Dijkstra algorithm
+     * on unit weights used to choose, so weights and parents are
+     * the same as before, in O(V + E) time.
+     */
+    template <class G>
+    PathTree<hop_type>
+    breadth_first_spt(const G& g, size_type src, BFSWorkspace& ws) {
+        PathTree<hop_type>    spt;
+
+        spt.weight.assign(g.size(), Vertex<Node>::DEFAULT_WEIGHT);
+        spt.parent.assign(g.size(), Vertex<Node>::DEFAULT_PARENT);
+        spt.weight[src] = 0;
+        breadth_first_search(g, src, [&](size_type u, size_type v) {
+            spt.weight[v] = spt.weight[u] + 1;
+            spt.parent[v] = u;
+            return true;
+        }, ws);
+        return spt;
+    }
+
+    template <class G>
+    PathTree<hop_type>
+    breadth_first_spt(const G& g, size_type src) {
+        BFSWorkspace    ws;
+        return breadth_first_spt(g, src, ws);
+    }
+
+    /* @fn dial_spt()
+     *
+     * Build a shortest path tree from src on graph g whose edges
+     * have small non-negative integer costs, using Dial's bucket
+     * queue. cost(u, v, w) gives the cost of the edge from u to v
+     * having weight w, which must not exceed max_cost. It runs in
+     * O(V + E + D) time, D being the largest distance.
+     */
+    template <class G, class W>
+    PathTree<hop_type>
+    dial_spt(const G& g, size_type src, W cost, hop_type max_cost) {
+        PathTree<hop_type>                         spt;
+        std::vector<std::vector<uint32_t>>         buckets(max_cost + 1);
+        DynamicBitset                              reached(g.size()), done(g.size());
+        size_type                                  pending = 1;
+
+        spt.weight.assign(g.size(), Vertex<Node>::DEFAULT_WEIGHT);
+        spt.parent.assign(g.size(), Vertex<Node>::DEFAULT_PARENT);
+        spt.weight[src] = 0;
+        reached.set(src);
+        buckets[0].push_back(src);
+        // all pending distances lie in [d, d + max_cost], so a
+        // circular array of max_cost + 1 buckets holds them.
+        for (hop_type d = 0; pending; ++d) {
+            std::vector<uint32_t>& b = buckets[d % (max_cost + 1)];
+            while (!b.empty()) {
+                size_type u = b.back();
+                b.pop_back();
+                --pending;
+                // skip entries left behind by shorter distances.
+                if (done.test_and_set(u))
+                    continue;
+                for_each_neighbor(g, u, [&](size_type v, double w) {
+                    hop_type c = cost(u, v, w);
+                    if (c < 0 || c > max_cost)
+                        throw std::range_error("Edge cost out of range.");
+                    if (done.test(v) ||
+                        (reached.test(v) && spt.weight[v] <= d + c))
+                        return;
+                    reached.set(v);
+                    spt.weight[v] = d + c;
+                    spt.parent[v] = u;
+                    buckets[(d + c) % (max_cost + 1)].push_back(v);
+                    ++pending;
+                });
+            }
+        }
+        return spt;
+    }
+
+    /* @fn dial_spt()
+     *
+     * Build a shortest path tree from src on graph g, taking the
+     * rounded weight of each edge as its cost, where edges having
+     * the default (negative) weight count as one hop.
+     */
+    template <class G>
+    PathTree<hop_type>
+    dial_spt(const G& g, size_type src) {
+        hop_type    max_cost = 1;
+        auto        cost = [](size_type, size_type, double w) {
+            return w < 0.0 ? hop_type(1) : static_cast<hop_type>(w + 0.5);
+        };
+
+        for (size_type u = 0; u < g.size(); ++u)
+            for_each_neighbor(g, u, [&](size_type v, double w) {
+                if (cost(u, v, w) > max_cost)
+                    max_cost = cost(u, v, w);
+            });
+        return dial_spt(g, src, cost, max_cost);
+    }
+
+    /* @fn weighted_spt()
+     *
+     * Build a shortest path tree from src on graph g weighted by the
+     * link costs of its edges, e.g., a graph built under a link
+     * quality constraint, where edges having the default (negative)
+     * weight cost one. Only paths of max_hops hops or fewer count:
+     * each vertex gets the cheapest of them, the one of fewest hops
+     * among equally cheap ones, and their hops are returned in hops.
+     * The search runs over states (v, h), vertex v reached in h hops,
+     * since a cheaper path of more hops must not hide a costlier one
+     * of fewer hops, which may be the only one to extend within the
+     * bound. A state is dropped once a state of its vertex of no more
+     * hops is settled, that one being no more costly. The parent of
+     * a vertex is the one before it on its path, and the path up to
+     * the parent need not be the parent's own. If max_hops is not
+     * below V - 1, no simple path is too long, and one state per
+     * vertex is kept. It runs in O(H (V + E) log(H V)) time on an
+     * indexed 4-ary heap, H being the number of states per vertex.
+     */
+    template <class G>
+    PathTree<double>
+    weighted_spt(const G& g, size_type src, std::vector<hop_type>& hops,
+                 hop_type max_hops) {
+        typedef std::pair<double, hop_type>    key_type;
+
+        PathTree<double>          spt;
+        size_type                 layers = g.size() > 0 &&
+                                           size_type(max_hops) < g.size() - 1
+                                           ? max_hops + 1 : 1;
+        IndexedHeap<key_type>     heap(g.size() * layers);
+        DynamicBitset             done(g.size() * layers);
+        // the vertex before each state on its path.
+        std::vector<id_type>      from(g.size() * layers, Vertex<Node>::DEFAULT_PARENT);
+        // fewest hops of the settled states of each vertex.
+        std::vector<hop_type>     least(g.size(), std::numeric_limits<hop_type>::max());
+        auto                      state = [&](size_type v, hop_type h) {
+            return v * layers + (layers == 1 ? 0 : h);
+        };
+
+        spt.weight.assign(g.size(), Vertex<Node>::DEFAULT_WEIGHT);
+        spt.parent.assign(g.size(), Vertex<Node>::DEFAULT_PARENT);
+        hops.assign(g.size(), Vertex<Node>::DEFAULT_WEIGHT);
+        if (g.size() == 0)
+            return spt;
+        heap.push(state(src, 0), key_type(0.0, 0));
+        while (!heap.empty()) {
+            size_type s = heap.pop();
+            size_type u = s / layers;
+            key_type  k = heap.key(s);
+
+            done.set(s);
+            if (k.second >= least[u])
+                continue;
+            if (least[u] == std::numeric_limits<hop_type>::max()) {
+                spt.weight[u] = k.first;
+                spt.parent[u] = from[s];
+                hops[u] = k.second;
+            }
+            least[u] = k.second;
+            if (k.second >= max_hops)
+                continue;
+            for_each_neighbor(g, u, [&](size_type v, double w) {
+                key_type  nk(k.first + (w < 0.0 ? 1.0 : w), k.second + 1);
+                size_type t = state(v, nk.second);
+                if (nk.second >= least[v] || done.test(t) ||
+                    (heap.contains(t) && !(nk < heap.key(t))))
+                    return;
+                heap.push_or_decrease(t, nk);
+                from[t] = u;
+            });
+        }
+        return spt;
+    }
+
+    /* @fn dijkstra_spt()
+     *
+     * Build a shortest path tree, in hops, from src to all given
+     * destinations. The hops from src to every vertex are recorded
+     * in the weight fields of the given graph, and the returned tree
+     * only keeps the paths to the destinations.
+     */
     template <class C>
     AdjacencyList<C>
     dijkstra_spt(AdjacencyList<C>& graph, size_type src,
                  std::vector<size_type> dests) {
-        std::vector<Vertex<C>> grey, black;
-        AdjacencyList<C> al, spt;
+        BFSWorkspace          ws;
+        AdjacencyList<C>      spt;
 
         if (src < 0 || src >= graph.size()) {
 #if !defined(NDEBUG)
@@ -181,69 +463,69 @@ namespace qosrnp {
             if (d < 0 || d >= graph.size() || d == src)
                 throw std::range_error("No such vertex in this graph!");
 
-        if (!is_connected(graph, src, dests))
+        if (!is_connected(graph, src, dests, ws))
             throw std::range_error("Source cannot connect all destinations.");
 
-        for (auto &v : graph) {
-            al.push_back(Vertex<C>(v.node(), al.size()));
-            spt.push_back(Vertex<C>(v.node(), al.size()));
-        }
+        for (auto &v : graph)
+            spt.push_back(Vertex<C>(v.node(), spt.size()));
 
-        al[src].set_weight(0);
-        grey.push_back(al[src]);
-
-        while (!grey.empty()) {
-            ssize_t index;
-            insertion_sort_descending(grey.begin(), grey.end());
-            Vertex<C> min = grey.back();
-            black.push_back(min);
-            grey.pop_back();
-            // update shortest distance to the source node and search 
-            // new grey nodes.
-            for (auto &e : graph[min.id()].neighbors()) {
-                // a node having a distance greater than the minimal 
-                // grey node must be a grey or white node.
-                if (al[e.tail()->id()].weight() > al[min.id()].weight() + 1) {
-                    al[e.tail()->id()].set_weight(al[min.id()].weight() + 1);
-                    al[e.tail()->id()].set_parent(min.id());
-                    // if this neighbor is a grey node, update its distance.
-                    if ((index = index_of(grey.begin(), grey.end(), *e.tail())) >= 0) {
-                        grey[index].set_weight(al[min.id()].weight() + 1);
-                    // if this neighbor is a white node, make it grey.
-                    } else if (index_of(black.begin(), black.end(), *e.tail()) == -1) {
-                        grey.push_back(al[e.tail()->id()]);
-                    // if this neighbor is a black node, error occurs.
-                    } else {
-                        std::cerr << "Algorithm run into wrong state." << std::endl;
-                        throw std::range_error("SPT updating black node");
-                    }
-                }
-            }
-            // adding edge between min node and its parent.
-            // source node has no parent.
-            if (min.id() != src) {
-//                 al[min.id()].push_neighbor(edge<N>(&al[min.id()], &al[min.parent()]));
-                 al[min.parent()].push_neighbor(Edge<C>(&al[min.parent()], &al[min.id()]));
-            }
-        }
-        
-        for (size_type i = 0; i < al.size(); ++i)
-            graph[i].set_weight(al[i].weight());
+        PathTree<hop_type> tree = breadth_first_spt(graph, src, ws);
+        for (size_type i = 0; i < graph.size(); ++i)
+            graph[i].set_weight(tree.weight[i]);
         // the leaves of this newly built shortest path tree may not be given
         // destinations. So, we now create a shortest path tree whose leaves
         // are only given destinations according to the newly built shortest
-        // path tree.
+        // path tree. A vertex already linked to its parent joins a path
+        // that has been added.
+        DynamicBitset linked(graph.size());
         for (size_type i = 0; i < dests.size(); ++i) {
-            for (id_type j = al[dests[i]].id(); j != src; j = al[j].parent()) {
-                spt[j].set_parent(al[j].parent());
-                if (has_edge(Edge<C>(&spt[spt[j].parent()], &spt[j]), 
-                             spt[spt[j].parent()].neighbors())) break;
+            for (id_type j = dests[i]; j != src; j = tree.parent[j]) {
+                if (linked.test_and_set(j)) break;
+                spt[j].set_parent(tree.parent[j]);
                 spt[spt[j].parent()].push_neighbor(Edge<C>(&spt[spt[j].parent()], &spt[j]));
             }
         }
         return spt;
     }
     
+    /* @fn dijkstra_spt()
+     *
+     * Build a shortest path tree, in hops, from src on a CSR graph.
+     * The weights and parents are the same as those recorded by
+     * dijkstra_spt() on an adjacency list of the same nodes, while
+     * all reachable vertices, not only the paths to dests, are kept.
+     * Vertices out of the graph are a misuse, and throw.
+     * @return the tree, or DISCONNECTED if src cannot reach all dests.
+     */
+    template <class C>
+    Result<PathTree<typename Vertex<C>::weight_type>>
+    dijkstra_spt(const CSRGraph<C>& graph, size_type src,
+                 const std::vector<size_type>& dests) {
+        BFSWorkspace    ws;
+
+        if (src < 0 || src >= graph.size()) {
+#if !defined(NDEBUG)
+            std::cerr << "function" << __func__
+                      << "in file"  << __FILE__
+                      << "at line"  << __LINE__
+                      << ": No such vertex in this graph!"
+                      << std::endl;
+            std::exit(-1);
+#else
+            throw std::range_error("No such vertex in this graph!");
+#endif
+        }
+
+        for (auto &d : dests)
+            if (d < 0 || d >= graph.size() || d == src)
+                throw std::range_error("No such vertex in this graph!");
+
+        if (!is_connected(graph, src, dests, ws))
+            return solve_status::DISCONNECTED;
+
+        return breadth_first_spt(graph, src, ws);
+    }
+    
     /* @fn max_hop
      * Find the maximum delta among given destinations from a graph.
      */
@@ -256,6 +538,18 @@ namespace qosrnp {
         return max;
     }
 
+    /* @fn max_hop
+     * Find the maximum hop budget among given destinations.
+     */
+    hop_type max_hop(const std::vector<size_type>& dests,
+                     const std::vector<hop_type>& budgets) {
+        hop_type max = 0;
+        for (auto &d : dests)
+            if (max < budgets[d])
+                max = budgets[d];
+        return max;
+    }
+
     /* @fn meet_hop
      * Check whether all destinations on a given graph
      * meet their hop constraints.
@@ -269,6 +563,173 @@ namespace qosrnp {
                 return false;
           return true;
     }
+
+    /* @fn meet_hop
+     * Check whether all destinations on a given graph
+     * meet their hop budgets, given by vertex id.
+     * @return true if meet, false otherwise.
+     */
+    bool meet_hop(const AdjacencyList<Node>& al,
+                  const std::vector<size_type>& dests,
+                  const std::vector<hop_type>& budgets) {
+        for (auto &i : dests)
+            if (al[i].weight() > budgets[i])
+                return false;
+        return true;
+    }
+
+    /* @fn meet_hop
+     * Check whether all destinations meet their hop budgets, given
+     * the hops from the source to each vertex, by vertex id.
+     * @return true if meet, false otherwise.
+     */
+    bool meet_hop(const std::vector<hop_type>& hops,
+                  const std::vector<size_type>& dests,
+                  const std::vector<hop_type>& budgets) {
+        for (auto &i : dests)
+            if (hops[i] > budgets[i])
+                return false;
+        return true;
+    }
+
+    /* @fn hop_distances
+     * Find the hops from src to each vertex of a graph. Vertices
+     * unreachable from src get the default weight of a vertex.
+     */
+    template <class G>
+    std::vector<hop_type>
+    hop_distances(const G& g, size_type src, BFSWorkspace& ws) {
+        return hop_distances(g, src, std::numeric_limits<hop_type>::max(), ws);
+    }
+
+    template <class G>
+    std::vector<hop_type>
+    hop_distances(const G& g, size_type src) {
+        BFSWorkspace    ws;
+        return hop_distances(g, src, ws);
+    }
+
+    /* @fn hop_distances
+     * Find the hops from src to each vertex no more than bound hops
+     * away. Vertices further away, or unreachable, get the default
+     * weight of a vertex. The search stops at the first vertex beyond
+     * bound, so it only scans the vertices within bound and their
+     * edges.
+     */
+    template <class G>
+    std::vector<hop_type>
+    hop_distances(const G& g, size_type src, hop_type bound, BFSWorkspace& ws) {
+        return hop_distances(g, std::vector<size_type>(1, src), bound, ws);
+    }
+
+    template <class G>
+    std::vector<hop_type>
+    hop_distances(const G& g, size_type src, hop_type bound) {
+        BFSWorkspace    ws;
+        return hop_distances(g, src, bound, ws);
+    }
+
+    /* @fn hop_distances
+     * Find the hops from each vertex to the nearest of srcs, e.g.,
+     * of many sinks, by one search from all of them, up to bound.
+     */
+    template <class G>
+    std::vector<hop_type>
+    hop_distances(const G& g, const std::vector<size_type>& srcs, hop_type bound,
+                  BFSWorkspace& ws) {
+        std::vector<hop_type>    hops(g.size(), Vertex<Node>::DEFAULT_WEIGHT);
+
+        for (auto &s : srcs)
+            hops[s] = 0;
+        breadth_first_search(g, srcs, [&](size_type u, size_type v) {
+            // levels are reached in order, so all the rest are
+            // beyond bound too.
+            if (hops[u] >= bound)
+                return false;
+            hops[v] = hops[u] + 1;
+            return true;
+        }, ws);
+        return hops;
+    }
+
+    template <class G>
+    std::vector<hop_type>
+    hop_distances(const G& g, const std::vector<size_type>& srcs, hop_type bound) {
+        BFSWorkspace    ws;
+        return hop_distances(g, srcs, bound, ws);
+    }
+
+    /* @fn meet_hop_without
+     * Check whether all destinations on a given graph still meet
+     * their hop constraints if the v-th vertex is switched off,
+     * without rebuilding the graph. The graph is restored before
+     * returning.
+     * @return true if meet, false otherwise.
+     */
+    bool meet_hop_without(AdjacencyList<Node>& al, const size_type& v,
+                          const size_type& src,
+                          const std::vector<size_type>& dests) {
+        std::vector<hop_type>    budgets;
+
+        for (auto &u : al)
+            budgets.push_back(u.node()->hop());
+        return meet_hop_without(al, v, src, dests, budgets);
+    }
+
+    bool meet_hop_without(AdjacencyList<Node>& al, const size_type& v,
+                          const size_type& src,
+                          const std::vector<size_type>& dests,
+                          const std::vector<hop_type>& budgets) {
+        bool    active = al.is_active(v), meet = true;
+
+        al.deactivate(v);
+        std::vector<hop_type> hops = hop_distances(al, src);
+        for (auto &d : dests)
+            if (hops[d] == Vertex<Node>::DEFAULT_WEIGHT ||
+                hops[d] > budgets[d]) {
+                meet = false;
+                break;
+            }
+        if (active)
+            al.reactivate(v);
+        return meet;
+    }
+
+    /* @fn meet_hop_without
+     * The same check on a masked view, where switching the v-th
+     * vertex off and on again only flips its bit.
+     */
+    template <class G>
+    bool meet_hop_without(MaskedGraph<G>& g, const size_type& v,
+                          const size_type& src,
+                          const std::vector<size_type>& dests,
+                          const std::vector<hop_type>& budgets) {
+        return meet_hop_without(g, v, std::vector<size_type>(1, src), dests, budgets);
+    }
+
+    /* @fn meet_hop_without
+     * The same check where each destination may reach any of srcs,
+     * searched no deeper than the largest budget of dests.
+     */
+    template <class G>
+    bool meet_hop_without(MaskedGraph<G>& g, const size_type& v,
+                          const std::vector<size_type>& srcs,
+                          const std::vector<size_type>& dests,
+                          const std::vector<hop_type>& budgets) {
+        bool    active = g.is_active(v), meet = true;
+
+        g.deactivate(v);
+        std::vector<hop_type> hops = hop_distances(g, srcs, max_hop(dests, budgets));
+        for (auto &d : dests)
+            if (hops[d] == Vertex<Node>::DEFAULT_WEIGHT ||
+                hops[d] > budgets[d]) {
+                meet = false;
+                break;
+            }
+        if (active)
+            g.activate(v);
+        return meet;
+    }
 }
 
 #endif
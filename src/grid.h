@@ -0,0 +1,126 @@
+#ifndef QOSRNP_GRID_H
+#define QOSRNP_GRID_H
+
+#include <vector>
+#include <unordered_map>
+#include <cmath>        // floor()
+#include <cstdint>      // int64_t
+#include <cstdlib>
+
+#include "header.h"
+#include "coordinate.h"
+
+namespace qosrnp {
+    // type declarations.
+    struct Cell;
+    struct CellHash;
+    template <class C> class Grid;
+
+    /* @struct Cell
+     *
+     * Integer coordinate of a cell in a uniform grid.
+     */
+    struct Cell {
+        int64_t    x;
+        int64_t    y;
+        int64_t    z;
+
+        bool operator==(const Cell& c) const {
+            return x == c.x && y == c.y && z == c.z;
+        }
+        bool operator!=(const Cell& c) const { return !(*this == c); }
+    };
+
+    struct CellHash {
+        size_t operator()(const Cell& c) const {
+            uint64_t h = static_cast<uint64_t>(c.x) * 73856093ULL;
+            h ^= static_cast<uint64_t>(c.y) * 19349663ULL;
+            h ^= static_cast<uint64_t>(c.z) * 83492791ULL;
+            return static_cast<size_t>(h);
+        }
+    };
+
+    /* @class Grid
+     *
+     * Uniform spatial grid which buckets nodes into cubic cells
+     * of a given side length. Two nodes whose distance is not
+     * greater than the side length always lie in the same or in
+     * adjacent cells, so when the side length is the maximal
+     * transmit power, only the 27 cells around a node need to
+     * be searched for its neighbors.
+     */
+    template <class C>
+    class Grid {
+    public:
+        typedef C                         node_type;
+        typedef std::vector<size_type>    bucket_type;
+
+        Grid() = delete;
+        template <class Itr> Grid(Itr, Itr, const coordinate_type&);
+        Grid(const Grid&) = default;
+        Grid(Grid&&) = default;
+        ~Grid() = default;
+
+        Grid& operator=(const Grid&) = default;
+        Grid& operator=(Grid&&) = default;
+
+        coordinate_type side() const { return _side; }
+        size_type size() const { return _cells.size(); }
+        size_type cells() const { return _buckets.size(); }
+
+        Cell cell_of(const Coordinate&) const;
+        // apply f to the index of each node in the cells around
+        // (and including) the cell of the i-th node.
+        template <class F> void for_each_candidate(size_type, F) const;
+
+    private:
+        coordinate_type                                  _side;
+        std::vector<Cell>                                _cells;
+        std::unordered_map<Cell, bucket_type, CellHash>  _buckets;
+    };
+
+    /* @fn Grid()
+     *
+     * Bucket nodes in [b, e) into cells with side length s.
+     * The index of a node is its position in [b, e).
+     */
+    template <class C>
+    template <class Itr>
+    Grid<C>::Grid(Itr b, Itr e, const coordinate_type& s)
+    : _side(s), _cells(), _buckets() {
+        for (Itr itr = b; itr != e; ++itr) {
+            _cells.push_back(cell_of((*itr)->coordinate()));
+            _buckets[_cells.back()].push_back(_cells.size() - 1);
+        }
+    }
+
+    template <class C>
+    Cell
+    Grid<C>::cell_of(const Coordinate& coor) const {
+        Cell c;
+        c.x = static_cast<int64_t>(std::floor(coor.x() / _side));
+        c.y = static_cast<int64_t>(std::floor(coor.y() / _side));
+        c.z = static_cast<int64_t>(std::floor(coor.z() / _side));
+        return c;
+    }
+
+    template <class C>
+    template <class F>
+    void
+    Grid<C>::for_each_candidate(size_type i, F f) const {
+        const Cell& c = _cells[i];
+        Cell        n;
+
+        for (n.x = c.x - 1; n.x <= c.x + 1; ++n.x)
+            for (n.y = c.y - 1; n.y <= c.y + 1; ++n.y)
+                for (n.z = c.z - 1; n.z <= c.z + 1; ++n.z) {
+                    auto itr = _buckets.find(n);
+                    if (itr == _buckets.end())
+                        continue;
+                    for (auto &j : itr->second)
+                        f(j);
+                }
+    }
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef QOSRNP_HEAP_H
+#define QOSRNP_HEAP_H
+
+#include <vector>
+#include <stdexcept>
+
+#include "header.h"
+
+namespace qosrnp {
+    // type declarations.
+    template <typename K, unsigned D> class IndexedHeap;
+
+    /* @class IndexedHeap
+     *
+     * D-ary min-heap of items 0 ... n-1, each having a key of type
+     * K. The position of each item in the heap is recorded, so the
+     * key of an item can be decreased in place. push(), pop() and
+     * decrease() take O(log_D n) key comparisons, and a wider heap
+     * makes decrease() cheaper at a small cost to pop(), which suits
+     * shortest path searches where decreases dominate.
+     */
+    template <typename K, unsigned D = 4>
+    class IndexedHeap {
+    public:
+        typedef K            key_type;
+
+        static const size_type   NPOS = static_cast<size_type>(-1);
+
+        IndexedHeap() = default;
+        explicit IndexedHeap(size_type n)
+        : _items(), _keys(n), _pos(n, NPOS) {}
+        IndexedHeap(const IndexedHeap&) = default;
+        IndexedHeap(IndexedHeap&&) = default;
+        ~IndexedHeap() = default;
+
+        IndexedHeap& operator=(const IndexedHeap&) = default;
+        IndexedHeap& operator=(IndexedHeap&&) = default;
+
+        bool empty() const { return _items.empty(); }
+        size_type size() const { return _items.size(); }
+        bool contains(size_type i) const { return _pos[i] != NPOS; }
+        const key_type& key(size_type i) const { return _keys[i]; }
+
+        // the item with the minimal key.
+        size_type top() const { return _items.front(); }
+
+        void push(size_type, const key_type&);
+        void decrease(size_type, const key_type&);
+        // push an item, or decrease its key if it is in the heap
+        // and the new key is less.
+        void push_or_decrease(size_type, const key_type&);
+        size_type pop();
+        // remove all items, keeping the capacity.
+        void clear();
+
+    private:
+        void sift_up(size_type);
+        void sift_down(size_type);
+        void place(size_type p, size_type i) { _items[p] = i; _pos[i] = p; }
+
+    private:
+        // items arranged as a D-ary heap.
+        std::vector<size_type>    _items;
+        // key of each item.
+        std::vector<key_type>     _keys;
+        // position of each item in _items, or NPOS.
+        std::vector<size_type>    _pos;
+    };
+
+    template <typename K, unsigned D>
+    const size_type IndexedHeap<K,D>::NPOS;
+
+    template <typename K, unsigned D>
+    void
+    IndexedHeap<K,D>::push(size_type i, const K& k) {
+        if (contains(i))
+            throw std::range_error("Item is already in the heap.");
+        _keys[i] = k;
+        _items.push_back(i);
+        _pos[i] = _items.size() - 1;
+        sift_up(_items.size() - 1);
+    }
+
+    template <typename K, unsigned D>
+    void
+    IndexedHeap<K,D>::decrease(size_type i, const K& k) {
+        if (!contains(i) || _keys[i] < k)
+            throw std::range_error("Key cannot be decreased.");
+        _keys[i] = k;
+        sift_up(_pos[i]);
+    }
+
+    template <typename K, unsigned D>
+    void
+    IndexedHeap<K,D>::push_or_decrease(size_type i, const K& k) {
+        if (!contains(i))
+            push(i, k);
+        else if (k < _keys[i])
+            decrease(i, k);
+    }
+
+    template <typename K, unsigned D>
+    size_type
+    IndexedHeap<K,D>::pop() {
+        size_type    i = _items.front();
+
+        place(0, _items.back());
+        _items.pop_back();
+        _pos[i] = NPOS;
+        if (!_items.empty())
+            sift_down(0);
+        return i;
+    }
+
+    template <typename K, unsigned D>
+    void
+    IndexedHeap<K,D>::clear() {
+        for (auto &i : _items)
+            _pos[i] = NPOS;
+        _items.clear();
+    }
+
+    template <typename K, unsigned D>
+    void
+    IndexedHeap<K,D>::sift_up(size_type p) {
+        size_type    i = _items[p];
+
+        while (p > 0) {
+            size_type parent = (p - 1) / D;
+            if (!(_keys[i] < _keys[_items[parent]]))
+                break;
+            place(p, _items[parent]);
+            p = parent;
+        }
+        place(p, i);
+    }
+
+    template <typename K, unsigned D>
+    void
+    IndexedHeap<K,D>::sift_down(size_type p) {
+        size_type    i = _items[p];
+
+        while (true) {
+            size_type first = p * D + 1, min = p;
+            const key_type* mk = &_keys[i];
+            for (size_type c = first; c < first + D && c < _items.size(); ++c)
+                if (_keys[_items[c]] < *mk) {
+                    min = c;
+                    mk = &_keys[_items[c]];
+                }
+            if (min == p)
+                break;
+            place(p, _items[min]);
+            p = min;
+        }
+        place(p, i);
+    }
+}
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef QOSRNP_HOP_MATRIX_H
+#define QOSRNP_HOP_MATRIX_H
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include <utility>      // swap(), move()
+#include <algorithm>    // min()
+#include <cstdint>      // uint8_t, uint32_t, uint64_t
+
+#include "header.h"
+#include "bfs.h"
+#include "graph_misc.h"
+#include "parallel.h"
+
+namespace qosrnp {
+    // type declarations.
+    class HopMatrix;
+
+    // function declarations.
+    bool meet_hop(const HopMatrix&, const std::vector<size_type>&,
+                  const std::vector<size_type>&, const std::vector<hop_type>&);
+
+    /* @class HopMatrix
+     *
+     * Hops between every pair of vertices of a graph whose edges go
+     * both ways, one byte each, capped at cap(): a pair cap() hops
+     * apart or more, or not connected, reads cap(). With the default
+     * cap of hop_constraint + 1, a lookup tells whether a pair meets
+     * the hop constraint in O(1) time, without a search. The matrix
+     * is kept in tiles of BLOCK x BLOCK pairs, only those on and
+     * above the diagonal, so it takes about n * n / 2 bytes, e.g.,
+     * 200 MB for 20000 vertices, and the pairs of nearby ids share
+     * cache lines. A row of tiles is filled by one bounded search
+     * per vertex, and rows are filled by up to given number of
+     * threads. It holds the hops with every vertex of the graph on,
+     * so it does not answer for views with vertices switched off.
+     */
+    class HopMatrix {
+    public:
+        typedef uint8_t      entry_type;
+
+        static const size_type    BLOCK = 64;
+
+        HopMatrix() : _n(0), _cap(0), _blocks(0), _entries() {}
+        template <class G>
+        explicit HopMatrix(const G&, hop_type = hop_constraint + 1, unsigned = 1);
+        HopMatrix(const HopMatrix&) = default;
+        HopMatrix(HopMatrix&&) = default;
+        ~HopMatrix() = default;
+
+        HopMatrix& operator=(const HopMatrix&) = default;
+        HopMatrix& operator=(HopMatrix&&) = default;
+
+        bool operator==(const HopMatrix& m) const {
+            return _n == m._n && _cap == m._cap && _entries == m._entries;
+        }
+        bool operator!=(const HopMatrix& m) const { return !(*this == m); }
+
+        // number of vertices.
+        size_type size() const { return _n; }
+        hop_type cap() const { return _cap; }
+        // number of bytes of the entries.
+        size_type bytes() const { return _entries.size(); }
+
+        // hops between u and v, or cap() if they are no closer.
+        hop_type hop(size_type u, size_type v) const { return _entries[offset(u, v)]; }
+        // hops between v and the nearest of srcs, or cap().
+        hop_type nearest(const std::vector<size_type>&, size_type) const;
+
+        // write the matrix in a binary format of this machine.
+        bool save(std::ostream&) const;
+        // read a matrix written by save(), and return false, keeping
+        // this one, if the stream does not hold one.
+        bool load(std::istream&);
+
+    private:
+        void allocate();
+        size_type offset(size_type u, size_type v) const {
+            if (u / BLOCK > v / BLOCK)
+                std::swap(u, v);
+            size_type bu = u / BLOCK, bv = v / BLOCK;
+            // tiles of the rows above bu, and those of row bu left of bv.
+            size_type t = bu * _blocks - bu * (bu - 1) / 2 + (bv - bu);
+            return (t * BLOCK + u % BLOCK) * BLOCK + v % BLOCK;
+        }
+
+    private:
+        size_type                    _n;
+        hop_type                     _cap;
+        size_type                    _blocks;
+        std::vector<entry_type>      _entries;
+    };
+
+    template <class G>
+    HopMatrix::HopMatrix(const G& g, hop_type cap, unsigned threads)
+    : _n(g.size()), _cap(cap), _blocks(0), _entries() {
+        if (cap < 1 || cap > 255)
+            throw std::range_error("Hop cap out of range.");
+        allocate();
+        parallel_for(_blocks, threads, [&](size_type b) {
+            BFSWorkspace    ws;
+
+            for (size_type u = b * BLOCK; u < std::min((b + 1) * BLOCK, _n); ++u) {
+                std::vector<hop_type> hops = hop_distances(g, u, _cap - 1, ws);
+                // the tiles of this row start at the diagonal one, and
+                // u has a line of BLOCK entries in each.
+                for (size_type bv = b; bv < _blocks; ++bv) {
+                    entry_type*    line = &_entries[offset(u, bv * BLOCK)];
+                    size_type      last = std::min((bv + 1) * BLOCK, _n);
+                    for (size_type v = bv * BLOCK; v < last; ++v)
+                        line[v % BLOCK] = static_cast<entry_type>(
+                            hops[v] < _cap ? hops[v] : _cap);
+                }
+            }
+        });
+    }
+
+    void
+    HopMatrix::allocate() {
+        _blocks = (_n + BLOCK - 1) / BLOCK;
+        _entries.assign(_blocks * (_blocks + 1) / 2 * BLOCK * BLOCK,
+                        static_cast<entry_type>(_cap));
+    }
+
+    hop_type
+    HopMatrix::nearest(const std::vector<size_type>& srcs, size_type v) const {
+        hop_type    h = _cap;
+
+        for (auto &s : srcs)
+            h = std::min(h, hop(s, v));
+        return h;
+    }
+
+    /* @fn save()
+     *
+     * Write a tag, the number of vertices, the cap and the tile size,
+     * and then the tiles as they are kept.
+     */
+    bool
+    HopMatrix::save(std::ostream& os) const {
+        const char    tag[4] = {'Q', 'H', 'M', '1'};
+        uint64_t      n = _n;
+        uint32_t      cap = _cap, block = BLOCK;
+
+        os.write(tag, sizeof(tag));
+        os.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        os.write(reinterpret_cast<const char*>(&cap), sizeof(cap));
+        os.write(reinterpret_cast<const char*>(&block), sizeof(block));
+        os.write(reinterpret_cast<const char*>(_entries.data()), _entries.size());
+        return static_cast<bool>(os);
+    }
+
+    bool
+    HopMatrix::load(std::istream& is) {
+        char         tag[4];
+        uint64_t     n;
+        uint32_t     cap, block;
+        HopMatrix    m;
+
+        is.read(tag, sizeof(tag));
+        is.read(reinterpret_cast<char*>(&n), sizeof(n));
+        is.read(reinterpret_cast<char*>(&cap), sizeof(cap));
+        is.read(reinterpret_cast<char*>(&block), sizeof(block));
+        if (!is || std::string(tag, sizeof(tag)) != "QHM1" || block != BLOCK ||
+            cap < 1 || cap > 255)
+            return false;
+        m._n = n;
+        m._cap = cap;
+        m.allocate();
+        is.read(reinterpret_cast<char*>(m._entries.data()), m._entries.size());
+        if (!is)
+            return false;
+        *this = std::move(m);
+        return true;
+    }
+
+    /* @fn meet_hop
+     * Check whether each destination is within its hop budget of one
+     * of srcs at least, by lookups in m. A pair m.cap() hops apart
+     * counts as beyond any budget.
+     * @return true if meet, false otherwise.
+     */
+    bool meet_hop(const HopMatrix& m, const std::vector<size_type>& srcs,
+                  const std::vector<size_type>& dests,
+                  const std::vector<hop_type>& budgets) {
+        for (auto &d : dests) {
+            hop_type h = m.nearest(srcs, d);
+            if (h == m.cap() || h > budgets[d])
+                return false;
+        }
+        return true;
+    }
+}
+
+#endif
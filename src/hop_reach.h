@@ -0,0 +1,139 @@
+#ifndef QOSRNP_HOP_REACH_H
+#define QOSRNP_HOP_REACH_H
+
+#include <vector>
+#include <algorithm>    // fill(), min()
+#include <cstdint>      // uint64_t
+
+#include "header.h"
+#include "bitset.h"
+#include "parallel.h"
+
+namespace qosrnp {
+    // type declarations.
+    class HopReach;
+
+    /* @class HopReach
+     *
+     * Which vertices each of many sources, e.g., the sensors, reaches
+     * within given hops. The sources are searched 64 at a time by a
+     * bit-parallel breadth first search: bit i of a word of a vertex
+     * tells whether the i-th source of the batch has reached it, so
+     * one pass over the edges extends the frontiers of all 64
+     * sources by a level. Building takes about E * h * S / 64 word
+     * operations for S sources, rather than S searches, and batches
+     * are searched by up to given number of threads, each writing
+     * only the words of its own batch, which are kept together.
+     */
+    class HopReach {
+    public:
+        typedef uint64_t     word_type;
+
+        static const size_type    WORD_BITS = 64;
+
+        HopReach() : _n(0), _bound(0), _sources(), _words() {}
+        template <class G>
+        HopReach(const G&, const std::vector<size_type>&, hop_type, unsigned = 1);
+        HopReach(const HopReach&) = default;
+        HopReach(HopReach&&) = default;
+        ~HopReach() = default;
+
+        HopReach& operator=(const HopReach&) = default;
+        HopReach& operator=(HopReach&&) = default;
+
+        // number of vertices.
+        size_type size() const { return _n; }
+        const std::vector<size_type>& sources() const { return _sources; }
+        hop_type bound() const { return _bound; }
+
+        // whether the i-th source reaches vertex v within bound hops.
+        bool within(size_type i, size_type v) const {
+            return (word(i / WORD_BITS, v) >> (i % WORD_BITS)) & 1;
+        }
+        // the vertices the i-th source reaches within bound hops.
+        DynamicBitset reach(size_type) const;
+        // the sources reaching vertex v within bound hops, by index.
+        DynamicBitset reached_by(size_type) const;
+        // number of sources reaching vertex v within bound hops.
+        size_type count(size_type) const;
+
+    private:
+        size_type batches() const { return (_sources.size() + WORD_BITS - 1) / WORD_BITS; }
+        const word_type& word(size_type b, size_type v) const { return _words[b * _n + v]; }
+
+    private:
+        size_type                 _n;
+        hop_type                  _bound;
+        std::vector<size_type>    _sources;
+        // the words of batch b are _words[b * _n, (b + 1) * _n).
+        std::vector<word_type>    _words;
+    };
+
+    template <class G>
+    HopReach::HopReach(const G& g, const std::vector<size_type>& srcs,
+                       hop_type bound, unsigned threads)
+    : _n(g.size()), _bound(bound), _sources(srcs), _words() {
+        _words.assign(batches() * _n, 0);
+        parallel_for(batches(), threads, [&](size_type b) {
+            word_type*                seen = &_words[b * _n];
+            std::vector<word_type>    frontier(_n, 0), next(_n, 0);
+            size_type                 first = b * WORD_BITS,
+                                      last = std::min(first + WORD_BITS, _sources.size());
+
+            for (size_type i = first; i < last; ++i) {
+                seen[_sources[i]] |= word_type(1) << (i - first);
+                frontier[_sources[i]] |= word_type(1) << (i - first);
+            }
+            for (hop_type h = 0; h < bound; ++h) {
+                bool    grown = false;
+
+                // push the frontier of each vertex to its neighbors.
+                for (size_type u = 0; u < _n; ++u)
+                    if (frontier[u])
+                        for_each_neighbor(g, u, [&](size_type v, double) {
+                            next[v] |= frontier[u];
+                        });
+                // keep the sources that reach a vertex for the first time.
+                for (size_type v = 0; v < _n; ++v) {
+                    next[v] &= ~seen[v];
+                    seen[v] |= next[v];
+                    grown = grown || next[v];
+                }
+                if (!grown)
+                    break;
+                frontier.swap(next);
+                std::fill(next.begin(), next.end(), 0);
+            }
+        });
+    }
+
+    DynamicBitset
+    HopReach::reach(size_type i) const {
+        DynamicBitset    res(_n);
+
+        for (size_type v = 0; v < _n; ++v)
+            if (within(i, v))
+                res.set(v);
+        return res;
+    }
+
+    DynamicBitset
+    HopReach::reached_by(size_type v) const {
+        DynamicBitset    res(_sources.size());
+
+        for (size_type b = 0; b < batches(); ++b)
+            res.data()[b] = word(b, v);
+        return res;
+    }
+
+    size_type
+    HopReach::count(size_type v) const {
+        size_type    cnt = 0;
+
+        for (size_type b = 0; b < batches(); ++b)
+            cnt += __builtin_popcountll(word(b, v));
+        return cnt;
+    }
+}
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef QOSRNP_ISLAND_H
+#define QOSRNP_ISLAND_H
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <exception>
+#include <memory>       // unique_ptr
+
+#include "header.h"
+#include "node.h"
+#include "bitset.h"
+#include "problem.h"
+#include "gqrnp.h"
+
+namespace qosrnp {
+    // type declarations.
+    class Mailbox;
+
+    // function declarations.
+    GAResult island_gqrnp(std::default_random_engine&, const std::vector<Node*>&,
+                          const GAOptions&, size_type, size_type);
+
+    /* @class Mailbox
+     *
+     * Lock-free single-slot mailbox carrying chromosomes from one
+     * thread to another. post() waits until the last letter is
+     * fetched, and fetch() waits until a letter is posted, so the
+     * k-th letter fetched is always the k-th one posted. Either side
+     * may close the mailbox when it leaves, after which neither side
+     * waits any longer.
+     */
+    class Mailbox {
+    public:
+        Mailbox() : _letter(), _full(false), _closed(false) {}
+        Mailbox(const Mailbox&) = delete;
+        Mailbox& operator=(const Mailbox&) = delete;
+
+        // post a letter, or return false if the mailbox is closed.
+        bool post(const DynamicBitset&);
+        // fetch a letter, or return false if the mailbox is closed
+        // and empty.
+        bool fetch(DynamicBitset&);
+        void close() { _closed.store(true, std::memory_order_release); }
+        bool closed() const { return _closed.load(std::memory_order_acquire); }
+
+    private:
+        DynamicBitset        _letter;
+        // whether _letter holds a letter not fetched yet.
+        std::atomic<bool>    _full;
+        std::atomic<bool>    _closed;
+    };
+
+    bool
+    Mailbox::post(const DynamicBitset& letter) {
+        while (_full.load(std::memory_order_acquire)) {
+            if (closed())
+                return false;
+            std::this_thread::yield();
+        }
+        if (closed())
+            return false;
+        _letter = letter;
+        _full.store(true, std::memory_order_release);
+        return true;
+    }
+
+    bool
+    Mailbox::fetch(DynamicBitset& letter) {
+        while (!_full.load(std::memory_order_acquire)) {
+            if (closed() && !_full.load(std::memory_order_acquire))
+                return false;
+            std::this_thread::yield();
+        }
+        letter = _letter;
+        _full.store(false, std::memory_order_release);
+        return true;
+    }
+
+    /* @fn island_gqrnp()
+     *
+     * Run gqrnp on given number of islands, each an independent
+     * population of opts.population children per generation bred on
+     * its own thread from its own engine, seeded from en. Every
+     * interval generations, each island posts its optimal solution
+     * to the next island of a ring and adds the one posted by the
+     * previous island to its population. Islands only wait for their
+     * neighbors at migrations, and a run without a target size or a
+     * time budget gives the same result for the same seed. An island
+     * stops on its own when it stalls or fails to make a child, and
+     * all islands stop once one reaches the target size or the time
+     * budget runs out. The best solution of all islands is returned,
+     * with the stop reason and generations of its island. No island
+     * is run if ga_certificate() finds the instance needs no run.
+     */
+    GAResult
+    island_gqrnp(std::default_random_engine& en, const std::vector<Node*>& nds,
+                 const GAOptions& opts, size_type islands, size_type interval) {
+        typedef std::chrono::steady_clock    clock_type;
+
+        clock_type::time_point                     start = clock_type::now();
+        const Problem                              pb = ga_problem(nds);
+        std::vector<std::unique_ptr<Evolution>>    evos;
+        std::vector<std::unique_ptr<Mailbox>>      boxes;
+        std::vector<unsigned>                      seeds(islands);
+        std::vector<GAResult>                      res(islands);
+        std::atomic<bool>                          stop(false);
+        std::atomic<int>                           stop_code(0);
+        std::vector<std::thread>                   pool;
+        std::exception_ptr                         err;
+        std::mutex                                 mtx;
+        auto                                       seconds = [&]() {
+            return std::chrono::duration<double>(clock_type::now() - start).count();
+        };
+
+        if (islands == 0 || interval == 0)
+            throw std::range_error("No island or no migration interval.");
+        if (!ga_certificate(pb, res[0], opts.verbose)) {
+            res[0].seconds = seconds();
+            return res[0];
+        }
+        for (size_type i = 0; i < islands; ++i) {
+            seeds[i] = en();
+            evos.push_back(std::unique_ptr<Evolution>(new Evolution(pb, opts)));
+            // the i-th mailbox carries letters to the i-th island.
+            boxes.push_back(std::unique_ptr<Mailbox>(new Mailbox()));
+        }
+
+        auto island = [&](size_type i) {
+            std::default_random_engine    ien(seeds[i]);
+            Evolution&                    evo = *evos[i];
+            Mailbox&                      inbox = *boxes[i];
+            Mailbox&                      outbox = *boxes[(i + 1) % islands];
+            DynamicBitset                 migrant;
+            size_type                     best, stalled = 0, g;
+
+            if (evo.seed(ien) != solve_status::OK) {
+                res[i].reason = stop_reason::RETRIES;
+                return;
+            }
+            best = evo.optimal().count();
+            res[i].reason = stop_reason::GENERATIONS;
+            for (g = 0; ; ++g) {
+                if (opts.target_size && best <= opts.target_size) {
+                    stop_code = static_cast<int>(stop_reason::TARGET_SIZE);
+                    stop = true;
+                }
+                if (opts.time_budget > 0.0 && seconds() >= opts.time_budget) {
+                    stop_code = static_cast<int>(stop_reason::TIME_BUDGET);
+                    stop = true;
+                }
+                if (stop) {
+                    res[i].reason = static_cast<stop_reason>(stop_code.load());
+                    break;
+                }
+                if (opts.stall_generations && stalled >= opts.stall_generations) {
+                    res[i].reason = stop_reason::STALLED;
+                    break;
+                }
+                if (g >= opts.generations)
+                    break;
+                if (evo.breed(ien) != solve_status::OK) {
+                    res[i].reason = stop_reason::RETRIES;
+                    break;
+                }
+                // migration, as long as the neighbors are there.
+                if (islands > 1 && (g + 1) % interval == 0) {
+                    outbox.post(evo.optimal());
+                    if (inbox.fetch(migrant))
+                        evo.immigrate(migrant);
+                }
+                if (evo.optimal().count() < best) {
+                    best = evo.optimal().count();
+                    stalled = 0;
+                } else
+                    ++stalled;
+            }
+            res[i].generations = g;
+        };
+        auto work = [&](size_type i) {
+            try {
+                island(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (!err)
+                    err = std::current_exception();
+                stop = true;
+            }
+            // leaving islands neither send nor receive any more.
+            boxes[i]->close();
+            boxes[(i + 1) % islands]->close();
+        };
+
+        for (size_type i = 1; i < islands; ++i)
+            pool.push_back(std::thread(work, i));
+        work(0);
+        for (auto &t : pool)
+            t.join();
+        if (err)
+            std::rethrow_exception(err);
+
+        // islands that could not seed their populations have no
+        // solution, and are only taken if all failed.
+        size_type    b = islands;
+        for (size_type i = 0; i < islands; ++i)
+            if (evos[i]->optimal().any() &&
+                (b == islands || evos[i]->optimal().count() < evos[b]->optimal().count()))
+                b = i;
+        if (b == islands)
+            b = 0;
+        if (opts.verbose)
+            for (size_type i = 0; i < islands; ++i)
+                std::cout << "island " << i << " optimal: " << evos[i]->optimal().count()
+                          << ", stopped by " << res[i].reason << " after "
+                          << res[i].generations << " generations" << std::endl;
+        for (size_type r = evos[b]->optimal().find_first(); r != DynamicBitset::NPOS;
+             r = evos[b]->optimal().find_next(r))
+            res[b].relays.insert(res[b].relays.end(), r);
+        res[b].seconds = seconds();
+        return res[b];
+    }
+}
+
+#endif
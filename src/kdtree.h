@@ -0,0 +1,219 @@
+#ifndef QOSRNP_KDTREE_H
+#define QOSRNP_KDTREE_H
+
+#include <vector>
+#include <queue>
+#include <utility>
+#include <algorithm>    // nth_element(), sort()
+#include <cstdlib>
+
+#include "header.h"
+#include "coordinate.h"
+
+namespace qosrnp {
+    // type declarations.
+    template <class C, unsigned D> class KDTree;
+
+    // function declarations.
+    coordinate_type axis_of(const Coordinate&, unsigned);
+
+    /* @fn axis_of()
+     *
+     * Return the a-th component of a coordinate, i.e.,
+     * 0 for x, 1 for y and 2 for z.
+     */
+    coordinate_type
+    axis_of(const Coordinate& coor, unsigned a) {
+        return a == 0 ? coor.x() : (a == 1 ? coor.y() : coor.z());
+    }
+
+    /* @class KDTree
+     *
+     * Static k-d tree over the coordinates of a range of nodes.
+     * The tree splits on the first D axes, i.e., D = 2 for planar
+     * deployments and D = 3 otherwise, while distances are always
+     * measured in three dimensions, so both variants return the
+     * same answers. Nodes are identified by their positions in
+     * the range the tree is built from.
+     */
+    template <class C, unsigned D = 3>
+    class KDTree {
+    public:
+        typedef C                                    node_type;
+        typedef std::pair<coordinate_type, size_type> hit_type;
+
+        KDTree() = delete;
+        template <class Itr> KDTree(Itr, Itr);
+        KDTree(const KDTree&) = default;
+        KDTree(KDTree&&) = default;
+        ~KDTree() = default;
+
+        KDTree& operator=(const KDTree&) = default;
+        KDTree& operator=(KDTree&&) = default;
+
+        size_type size() const { return _points.size(); }
+        const Coordinate& operator[](size_type i) const { return _points[i]; }
+
+        // collect the nodes within given distance of a coordinate.
+        void radius(const Coordinate&, const coordinate_type&,
+                    std::vector<size_type>&) const;
+        // return the k nodes nearest to a coordinate, nearest first.
+        std::vector<size_type> nearest(const Coordinate&, size_type) const;
+        // apply f to each pair (i, j), i < j, of nodes within
+        // given distance of each other.
+        template <class F> void pairs_within(const coordinate_type&, F) const;
+
+    private:
+        void build(size_type, size_type, unsigned);
+        void radius(size_type, size_type, unsigned, const Coordinate&,
+                    const coordinate_type&, std::vector<size_type>&) const;
+        void nearest(size_type, size_type, unsigned, const Coordinate&,
+                     size_type, std::priority_queue<hit_type>&) const;
+
+    private:
+        // coordinates of nodes, in the order they are given.
+        std::vector<Coordinate>    _points;
+        // node indices arranged as an implicit tree, the median of
+        // each range [lo, hi) is the root of the subtree on it.
+        std::vector<size_type>     _index;
+    };
+
+    template <class C, unsigned D>
+    template <class Itr>
+    KDTree<C,D>::KDTree(Itr b, Itr e)
+    : _points(), _index() {
+        for (Itr itr = b; itr != e; ++itr) {
+            _points.push_back((*itr)->coordinate());
+            _index.push_back(_index.size());
+        }
+        build(0, _index.size(), 0);
+    }
+
+    template <class C, unsigned D>
+    void
+    KDTree<C,D>::build(size_type lo, size_type hi, unsigned a) {
+        if (hi - lo <= 1)
+            return;
+        size_type mid = lo + (hi - lo) / 2;
+        std::nth_element(_index.begin() + lo, _index.begin() + mid,
+                         _index.begin() + hi,
+                         [&](size_type i, size_type j) {
+                             return axis_of(_points[i], a) < axis_of(_points[j], a);
+                         });
+        build(lo, mid, (a + 1) % D);
+        build(mid + 1, hi, (a + 1) % D);
+    }
+
+    /* @fn radius()
+     *
+     * Collect into res the nodes whose distances to coor are not
+     * greater than r, in no particular order.
+     */
+    template <class C, unsigned D>
+    void
+    KDTree<C,D>::radius(const Coordinate& coor, const coordinate_type& r,
+                        std::vector<size_type>& res) const {
+        radius(0, _index.size(), 0, coor, r, res);
+    }
+
+    template <class C, unsigned D>
+    void
+    KDTree<C,D>::radius(size_type lo, size_type hi, unsigned a,
+                        const Coordinate& coor, const coordinate_type& r,
+                        std::vector<size_type>& res) const {
+        if (lo >= hi)
+            return;
+        size_type          mid = lo + (hi - lo) / 2;
+        const Coordinate&  p = _points[_index[mid]];
+        coordinate_type    diff = axis_of(coor, a) - axis_of(p, a);
+
+        if (distance(coor, p) <= r)
+            res.push_back(_index[mid]);
+        // nodes on the left have no greater a-th component than p,
+        // and nodes on the right have no less.
+        if (diff <= r)
+            radius(lo, mid, (a + 1) % D, coor, r, res);
+        if (-diff <= r)
+            radius(mid + 1, hi, (a + 1) % D, coor, r, res);
+    }
+
+    /* @fn nearest()
+     *
+     * Return the k nodes nearest to coor ordered by distance, ties
+     * broken by the smaller index. Fewer than k nodes are returned
+     * if the tree is smaller than k.
+     */
+    template <class C, unsigned D>
+    std::vector<size_type>
+    KDTree<C,D>::nearest(const Coordinate& coor, size_type k) const {
+        std::priority_queue<hit_type>   best;
+        std::vector<size_type>          res;
+
+        if (k == 0)
+            return res;
+        nearest(0, _index.size(), 0, coor, k, best);
+        while (!best.empty()) {
+            res.push_back(best.top().second);
+            best.pop();
+        }
+        std::reverse(res.begin(), res.end());
+        return res;
+    }
+
+    template <class C, unsigned D>
+    void
+    KDTree<C,D>::nearest(size_type lo, size_type hi, unsigned a,
+                         const Coordinate& coor, size_type k,
+                         std::priority_queue<hit_type>& best) const {
+        if (lo >= hi)
+            return;
+        size_type          mid = lo + (hi - lo) / 2;
+        const Coordinate&  p = _points[_index[mid]];
+        coordinate_type    diff = axis_of(coor, a) - axis_of(p, a);
+        hit_type           hit(distance(coor, p), _index[mid]);
+
+        // best keeps the k nearest nodes found so far, the
+        // farthest one on the top.
+        if (best.size() < k) {
+            best.push(hit);
+        } else if (hit < best.top()) {
+            best.pop();
+            best.push(hit);
+        }
+        // search the side containing coor first, then the other
+        // side only if it may hold a nearer node.
+        if (diff <= 0) {
+            nearest(lo, mid, (a + 1) % D, coor, k, best);
+            if (best.size() < k || -diff <= best.top().first)
+                nearest(mid + 1, hi, (a + 1) % D, coor, k, best);
+        } else {
+            nearest(mid + 1, hi, (a + 1) % D, coor, k, best);
+            if (best.size() < k || diff <= best.top().first)
+                nearest(lo, mid, (a + 1) % D, coor, k, best);
+        }
+    }
+
+    /* @fn pairs_within()
+     *
+     * Apply f(i, j) to each pair of nodes, i < j, whose distance
+     * is not greater than r. Pairs are enumerated ordered by i
+     * and then by j.
+     */
+    template <class C, unsigned D>
+    template <class F>
+    void
+    KDTree<C,D>::pairs_within(const coordinate_type& r, F f) const {
+        std::vector<size_type>   res;
+
+        for (size_type i = 0; i < _points.size(); ++i) {
+            res.clear();
+            radius(_points[i], r, res);
+            std::sort(res.begin(), res.end());
+            for (auto &j : res)
+                if (j > i)
+                    f(i, j);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef QOSRNP_MASKED_GRAPH_H
+#define QOSRNP_MASKED_GRAPH_H
+
+#include <stdexcept>
+
+#include "header.h"
+#include "bitset.h"
+
+namespace qosrnp {
+    // type declarations.
+    template <class G> class MaskedGraph;
+
+    // function declarations.
+    template <class G, class F>
+    void for_each_neighbor(const MaskedGraph<G>&, size_type, F);
+
+    /* @class MaskedGraph
+     *
+     * View of a prebuilt graph of type G, e.g., a CSRGraph, where
+     * only the vertices set in a mask are switched on, and edges
+     * with an endpoint switched off are skipped. Switching a vertex
+     * on or off costs a bit flip rather than rebuilding the graph or
+     * editing its edges, so many subgraphs of one deployment can be
+     * evaluated, at the same time if each has its own view. It is
+     * accepted wherever for_each_neighbor() is, e.g., by the
+     * traversals of graph_misc.h and by frontier_cover(). The viewed
+     * graph must outlive the view.
+     */
+    template <class G>
+    class MaskedGraph {
+    public:
+        typedef G                           graph_type;
+        typedef typename G::node_type       node_type;
+
+        explicit MaskedGraph(const G&);
+        MaskedGraph(const G&, const DynamicBitset&);
+        MaskedGraph(const MaskedGraph&) = default;
+        MaskedGraph(MaskedGraph&&) = default;
+        ~MaskedGraph() = default;
+
+        MaskedGraph& operator=(const MaskedGraph&) = default;
+        MaskedGraph& operator=(MaskedGraph&&) = default;
+
+        size_type size() const { return _graph->size(); }
+        const G& graph() const { return *_graph; }
+        const DynamicBitset& mask() const { return _on; }
+
+        bool is_active(size_type i) const { return _on.test(i); }
+        void activate(size_type i) { _on.set(i); }
+        void deactivate(size_type i) { _on.reset(i); }
+
+    private:
+        const G*         _graph;
+        DynamicBitset    _on;
+    };
+
+    /* @fn MaskedGraph()
+     *
+     * View graph g with all its vertices switched on.
+     */
+    template <class G>
+    MaskedGraph<G>::MaskedGraph(const G& g)
+    : _graph(&g), _on(g.size()) {
+        for (size_type i = 0; i < g.size(); ++i)
+            _on.set(i);
+    }
+
+    /* @fn MaskedGraph()
+     *
+     * View graph g with the vertices set in mask on switched on.
+     */
+    template <class G>
+    MaskedGraph<G>::MaskedGraph(const G& g, const DynamicBitset& on)
+    : _graph(&g), _on(on) {
+        if (on.size() != g.size())
+            throw std::range_error("Mask of a different size.");
+    }
+
+    /* @fn for_each_neighbor()
+     *
+     * Apply f(j, w) to the index j and the edge weight w of each
+     * neighbor of the v-th vertex switched on, if v is switched on.
+     */
+    template <class G, class F>
+    void
+    for_each_neighbor(const MaskedGraph<G>& g, size_type v, F f) {
+        if (!g.is_active(v))
+            return;
+        for_each_neighbor(g.graph(), v, [&](size_type j, double w) {
+            if (g.is_active(j))
+                f(j, w);
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef QOSRNP_MEMO_CACHE_H
+#define QOSRNP_MEMO_CACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <cstdint>      // uint64_t
+
+#include "header.h"
+#include "bitset.h"
+
+namespace qosrnp {
+    // type declarations.
+    template <class V> class MemoCache;
+
+    // function declarations.
+    uint64_t hash_bits(const DynamicBitset&);
+
+    /* @fn hash_bits()
+     *
+     * 64-bit hash of the size and the words of a bitset, mixing each
+     * word by the finalizer of splitmix64.
+     */
+    uint64_t
+    hash_bits(const DynamicBitset& bs) {
+        uint64_t    h = bs.size() * 0x9e3779b97f4a7c15ULL;
+
+        for (size_type k = 0; k < bs.words(); ++k) {
+            uint64_t z = h ^ (bs.data()[k] + 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            h = z ^ (z >> 31);
+        }
+        return h;
+    }
+
+    /* @class MemoCache
+     *
+     * Bounded cache of values of type V computed from bitsets, e.g.,
+     * the relays a deterministic solver places on a crossover pool,
+     * keyed by the 64-bit hash of the bitset. The key itself is kept
+     * and compared, so a hash collision is a miss rather than a wrong
+     * value. Once capacity values are cached, the least recently used
+     * one is evicted. Hits and misses are counted. A cache is not
+     * safe to share between threads.
+     */
+    template <class V>
+    class MemoCache {
+    public:
+        typedef V            value_type;
+
+        explicit MemoCache(size_type capacity = 4096)
+        : _capacity(capacity), _hits(0), _misses(0), _entries(), _index() {}
+        MemoCache(const MemoCache&) = delete;
+        MemoCache(MemoCache&&) = default;
+        ~MemoCache() = default;
+
+        MemoCache& operator=(const MemoCache&) = delete;
+        MemoCache& operator=(MemoCache&&) = default;
+
+        size_type size() const { return _entries.size(); }
+        size_type capacity() const { return _capacity; }
+        size_type hits() const { return _hits; }
+        size_type misses() const { return _misses; }
+
+        // the value cached for given key, valid until the next insert,
+        // or nullptr.
+        const value_type* find(const DynamicBitset&);
+        void insert(const DynamicBitset&, const value_type&);
+        void clear() { _entries.clear(); _index.clear(); _hits = _misses = 0; }
+
+    private:
+        struct Entry {
+            uint64_t         hash;
+            DynamicBitset    key;
+            value_type       value;
+        };
+        // entries from the most recently used.
+        typedef std::list<Entry>    list_type;
+
+    private:
+        size_type                                                      _capacity;
+        size_type                                                      _hits;
+        size_type                                                      _misses;
+        list_type                                                      _entries;
+        std::unordered_map<uint64_t, typename list_type::iterator>    _index;
+    };
+
+    template <class V>
+    const V*
+    MemoCache<V>::find(const DynamicBitset& key) {
+        auto    itr = _index.find(hash_bits(key));
+
+        if (itr == _index.end() || itr->second->key != key) {
+            ++_misses;
+            return nullptr;
+        }
+        ++_hits;
+        _entries.splice(_entries.begin(), _entries, itr->second);
+        return &itr->second->value;
+    }
+
+    template <class V>
+    void
+    MemoCache<V>::insert(const DynamicBitset& key, const V& value) {
+        uint64_t    h = hash_bits(key);
+        auto        itr = _index.find(h);
+
+        if (_capacity == 0)
+            return;
+        // a key of the same hash, equal or not, is replaced.
+        if (itr != _index.end()) {
+            _entries.erase(itr->second);
+            _index.erase(itr);
+        } else if (_entries.size() >= _capacity) {
+            _index.erase(_entries.back().hash);
+            _entries.pop_back();
+        }
+        _entries.push_front(Entry{h, key, value});
+        _index[h] = _entries.begin();
+    }
+}
+
+#endif
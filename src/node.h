@@ -6,6 +6,8 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <vector>
+#include <algorithm>    // min()
+#include <cmath>        // pow()
 
 #include "header.h"
 #include "coordinate.h"
@@ -23,6 +25,9 @@ namespace qosrnp {
     coordinate_type distance(const Node&, const Node&);
     std::ostream& operator<<(std::ostream&, const Node&);
     bool is_neighbor(const Node&, const Node&);
+    quality_type link_quality(const Node&, const Node&);
+    double link_cost(const Node&, const Node&);
+    Node* copy_node(const Node&);
 
     /* @class Node
      *
@@ -149,6 +154,23 @@ namespace qosrnp {
         ~Sink() = default;
     };
 
+    /* @fn copy_node()
+     *
+     * Allocate a copy of given node, of the same node type.
+     */
+    Node*
+    copy_node(const Node& n) {
+        switch (n.type()) {
+            case node_type::SENSOR:
+                return new Sensor(n.coordinate(), n.power(), n.hop(), n.id());
+            case node_type::RELAY:
+                return new Relay(n.coordinate(), n.power(), n.hop(), n.id());
+            case node_type::SINK:
+                return new Sink(n.coordinate(), n.power(), n.hop(), n.id());
+        }
+        return nullptr;
+    }
+
     /* @fn Nodes
      *
      * A vector of Nodes.
@@ -200,6 +222,36 @@ namespace qosrnp {
         }
         return false;
     }
+
+    /* @fn link_quality()
+     *
+     * Estimate the packet reception ratio of the link between two
+     * nodes, which decays with the fourth power of their distance
+     * relative to the range of the link, i.e., the lower transmit
+     * power of the two. Nodes that are not neighbors have no link.
+     */
+    quality_type
+    link_quality(const Node& n1, const Node& n2) {
+        if (!is_neighbor(n1, n2))
+            return 0.0;
+        coordinate_type range = std::min(n1.power(), n2.power());
+        if (range <= 0.0)
+            return 1.0;
+        return 1.0 - std::pow(distance(n1, n2) / range, 4);
+    }
+
+    /* @fn link_cost()
+     *
+     * Expected transmission count (ETX) of the link between two
+     * nodes, i.e., the expected number of transmissions, including
+     * retransmissions, for a packet and its acknowledgement to get
+     * across the link.
+     */
+    double
+    link_cost(const Node& n1, const Node& n2) {
+        quality_type q = link_quality(n1, n2);
+        return 1.0 / (q * q);
+    }
 }
 
 #endif
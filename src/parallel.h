@@ -0,0 +1,60 @@
+#ifndef QOSRNP_PARALLEL_H
+#define QOSRNP_PARALLEL_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <algorithm>    // min()
+
+#include "header.h"
+
+namespace qosrnp {
+    // function declarations.
+    template <class F>
+    void parallel_for(size_type, unsigned, F);
+
+    /* @fn parallel_for()
+     *
+     * Call f(i) for each i in [0, n) on a pool of up to given number
+     * of threads, the calling thread included, which take the next
+     * index as they become free. The calls must not depend on each
+     * other. The first exception thrown by a call is rethrown once
+     * all threads are joined. With one thread, the calls are made
+     * in order on the calling thread.
+     */
+    template <class F>
+    void
+    parallel_for(size_type n, unsigned threads, F f) {
+        std::atomic<size_type>      next(0);
+        std::vector<std::thread>    pool;
+        std::exception_ptr          err;
+        std::mutex                  mtx;
+        auto                        work = [&]() {
+            for (size_type i; (i = next++) < n; )
+                try {
+                    f(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    if (!err)
+                        err = std::current_exception();
+                }
+        };
+
+        if (threads <= 1 || n <= 1) {
+            for (size_type i = 0; i < n; ++i)
+                f(i);
+            return;
+        }
+        for (unsigned t = 1; t < std::min<size_type>(threads, n); ++t)
+            pool.push_back(std::thread(work));
+        work();
+        for (auto &t : pool)
+            t.join();
+        if (err)
+            std::rethrow_exception(err);
+    }
+}
+
+#endif
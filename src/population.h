@@ -0,0 +1,147 @@
+#ifndef QOSRNP_POPULATION_H
+#define QOSRNP_POPULATION_H
+
+#include <vector>
+#include <set>
+#include <algorithm>    // copy()
+#include <stdexcept>
+
+#include "header.h"
+#include "bitset.h"
+
+namespace qosrnp {
+    // type declarations.
+    class Population;
+
+    /* @class Population
+     *
+     * Chromosomes of a GA, each a bitset of a fixed number of bits,
+     * e.g., the relays placed among the nodes, stored one after
+     * another in one array of words. Copying chromosomes or whole
+     * populations copies words with no allocation per chromosome,
+     * and crossover pools and fitness are word-wise unions and
+     * popcounts.
+     */
+    class Population {
+    public:
+        typedef DynamicBitset::word_type    word_type;
+
+        Population() : _bits(0), _words(0), _size(0), _data() {}
+        explicit Population(size_type bits, size_type n = 0)
+        : _bits(bits), _words(DynamicBitset(bits).words()), _size(n),
+          _data(n * _words, 0) {}
+        Population(const Population&) = default;
+        Population(Population&&) = default;
+        ~Population() = default;
+
+        Population& operator=(const Population&) = default;
+        Population& operator=(Population&&) = default;
+
+        // number of chromosomes.
+        size_type size() const { return _size; }
+        bool empty() const { return _size == 0; }
+        // number of bits, and of words, of a chromosome.
+        size_type bits() const { return _bits; }
+        size_type words() const { return _words; }
+
+        const word_type* data(size_type i) const { return _data.data() + i * _words; }
+        word_type* data(size_type i) { return _data.data() + i * _words; }
+
+        // number of bits set in the i-th chromosome.
+        size_type count(size_type) const;
+        bool test(size_type i, size_type b) const {
+            return (data(i)[b / DynamicBitset::WORD_BITS] >>
+                    (b % DynamicBitset::WORD_BITS)) & 1;
+        }
+        DynamicBitset chromosome(size_type) const;
+        std::set<size_type> to_set(size_type) const;
+        // or the i-th chromosome into a bitset of the same size.
+        void unite(size_type, DynamicBitset&) const;
+
+        void set(size_type, const DynamicBitset&);
+        void push_back(const DynamicBitset&);
+        // append the i-th chromosome of a population of the same width.
+        void push_back(const Population&, size_type);
+        void append(const Population&);
+        void resize(size_type n) { _size = n; _data.resize(n * _words, 0); }
+        void reserve(size_type n) { _data.reserve(n * _words); }
+        void clear() { _size = 0; _data.clear(); }
+
+    private:
+        void check_width(size_type) const;
+
+    private:
+        size_type                 _bits;
+        size_type                 _words;
+        size_type                 _size;
+        std::vector<word_type>    _data;
+    };
+
+    void
+    Population::check_width(size_type bits) const {
+        if (bits != _bits)
+            throw std::range_error("Chromosome of a different size.");
+    }
+
+    size_type
+    Population::count(size_type i) const {
+        size_type    cnt = 0;
+        for (size_type k = 0; k < _words; ++k)
+            cnt += __builtin_popcountll(data(i)[k]);
+        return cnt;
+    }
+
+    DynamicBitset
+    Population::chromosome(size_type i) const {
+        DynamicBitset    ch(_bits);
+
+        std::copy(data(i), data(i) + _words, ch.data());
+        return ch;
+    }
+
+    std::set<size_type>
+    Population::to_set(size_type i) const {
+        std::set<size_type>    s;
+
+        for (size_type b = 0; b < _bits; ++b)
+            if (test(i, b))
+                s.insert(s.end(), b);
+        return s;
+    }
+
+    void
+    Population::unite(size_type i, DynamicBitset& bs) const {
+        check_width(bs.size());
+        for (size_type k = 0; k < _words; ++k)
+            bs.data()[k] |= data(i)[k];
+    }
+
+    void
+    Population::set(size_type i, const DynamicBitset& ch) {
+        check_width(ch.size());
+        std::copy(ch.data(), ch.data() + _words, data(i));
+    }
+
+    void
+    Population::push_back(const DynamicBitset& ch) {
+        check_width(ch.size());
+        resize(_size + 1);
+        set(_size - 1, ch);
+    }
+
+    void
+    Population::push_back(const Population& po, size_type i) {
+        check_width(po.bits());
+        _data.insert(_data.end(), po.data(i), po.data(i) + _words);
+        ++_size;
+    }
+
+    void
+    Population::append(const Population& po) {
+        check_width(po.bits());
+        _data.insert(_data.end(), po._data.begin(), po._data.end());
+        _size += po._size;
+    }
+}
+
+#endif
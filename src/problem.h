@@ -0,0 +1,175 @@
+#ifndef QOSRNP_PROBLEM_H
+#define QOSRNP_PROBLEM_H
+
+#include <vector>
+#include <stdexcept>
+
+#include "header.h"
+#include "node.h"
+#include "graph.h"
+#include "csr_graph.h"
+#include "masked_graph.h"
+#include "graph_misc.h"
+#include "bitset.h"
+#include "context.h"
+#include "result.h"
+
+namespace qosrnp {
+    // type declarations.
+    class Problem;
+
+    // function declarations.
+    void find_terminals(const SolveContext&, std::vector<size_type>&,
+                        std::vector<size_type>&);
+    AdjacencyList<Node> active_graph(const SolveContext&);
+
+    /* @fn find_terminals()
+     *
+     * Find the ids of the sinks, ensuring that a sink is given at
+     * least, and the ids of the sensors, which are the destinations.
+     */
+    void
+    find_terminals(const SolveContext& ctx, std::vector<size_type>& srcs,
+                   std::vector<size_type>& dests) {
+        srcs.clear();
+        dests.clear();
+        for (auto &n : ctx.nodes())
+            if (n->type() == node_type::SINK)
+                srcs.push_back(n->id());
+            else if (n->type() == node_type::SENSOR)
+                dests.push_back(n->id());
+        if (srcs.empty())
+            throw std::range_error("No sink is given");
+    }
+
+    /* @fn active_graph()
+     *
+     * Build the graph of the nodes of a context, where the nodes
+     * switched off have no edges.
+     */
+    AdjacencyList<Node>
+    active_graph(const SolveContext& ctx) {
+        AdjacencyList<Node>    res(ctx.nodes().begin(), ctx.nodes().end());
+
+        for (size_type i = 0; i < ctx.size(); ++i)
+            if (!ctx.is_active(i))
+                res.deactivate(i);
+        return res;
+    }
+
+    /* @class Problem
+     *
+     * A relay placement instance prepared once for many solves that
+     * only differ in which relays are switched on, e.g., the children
+     * of a GA run. It keeps the context it was made from, the sinks
+     * and the sensors, whether the sensors and the sinks alone meet
+     * the hop constraints, the graph of the nodes, and the hops from
+     * the nearest sink on that graph with the nodes of the context
+     * switched on. A sensor may send to any sink, so the hops of all
+     * sinks come from one search seeded with every sink. A solve
+     * views the graph through a mask of the nodes it switches on, so
+     * no graph is built per solve. Switching relays
+     * off only lengthens paths, so if the sensors cannot meet their
+     * constraints with every relay on, no mask can, and the sensors
+     * that cannot are kept as a certificate that no placement exists.
+     * A Problem is only read by the solvers, and may be shared by
+     * solves running at the same time.
+     */
+    class Problem {
+    public:
+        explicit Problem(const SolveContext&);
+        Problem(const Problem&) = delete;
+        Problem(Problem&&) = default;
+        ~Problem() = default;
+
+        Problem& operator=(const Problem&) = delete;
+        Problem& operator=(Problem&&) = default;
+
+        size_type size() const { return _ctx.size(); }
+        const SolveContext& context() const { return _ctx; }
+        const std::vector<size_type>& sinks() const { return _sinks; }
+        const std::vector<size_type>& sensors() const { return _sensors; }
+
+        // whether the sensors and the sinks alone meet the hop constraints.
+        bool sensors_suffice() const { return _sensors_suffice; }
+        // whether the sensors meet the hop constraints with every node
+        // switched on in the context, and why not if they do not.
+        bool feasible() const { return _status == solve_status::OK; }
+        solve_status status() const { return _status; }
+        // the sensors that do not, i.e., that no sink can reach
+        // within their hop budgets.
+        const std::vector<size_type>& late_sensors() const { return _late; }
+
+        // the graph of all the nodes.
+        const CSRGraph<Node>& graph() const { return _graph; }
+        // hops from the nearest sink on the graph with mask() switched
+        // on, up to the largest hop budget of the sensors.
+        const std::vector<hop_type>& hops() const { return _hops; }
+
+        // the nodes switched on in the context.
+        const DynamicBitset& mask() const { return _mask; }
+        // view of the graph where the nodes switched on are those in
+        // both given mask and mask().
+        MaskedGraph<CSRGraph<Node>> view(const DynamicBitset&) const;
+
+    private:
+        SolveContext              _ctx;
+        std::vector<size_type>    _sinks;
+        std::vector<size_type>    _sensors;
+        bool                      _sensors_suffice;
+        solve_status              _status;
+        CSRGraph<Node>            _graph;
+        DynamicBitset             _mask;
+        std::vector<hop_type>     _hops;
+        std::vector<size_type>    _late;
+    };
+
+    Problem::Problem(const SolveContext& ctx)
+    : _ctx(ctx), _sinks(), _sensors(), _sensors_suffice(false),
+      _status(solve_status::OK), _graph(ctx.nodes().begin(), ctx.nodes().end()),
+      _mask(ctx.size()), _hops(), _late() {
+        DynamicBitset    terminals(size());
+        hop_type         bound;
+
+        find_terminals(_ctx, _sinks, _sensors);
+        bound = max_hop(_sensors, ctx.hops());
+        for (size_type i = 0; i < size(); ++i)
+            if (_ctx.is_active(i))
+                _mask.set(i);
+        // view the graph only having edges bewteen sensors
+        // and sinks.
+        for (auto &s : _sinks)
+            terminals.set(s);
+        for (auto &s : _sensors)
+            terminals.set(s);
+        terminals &= _mask;
+        MaskedGraph<CSRGraph<Node>>    tmp(_graph, terminals);
+        // check whether the sinks connect all the sensors on this
+        // graph, and whether they meet delay constraints.
+        if (is_connected(tmp, _sinks, _sensors))
+            _sensors_suffice = meet_hop(hop_distances(tmp, _sinks, bound),
+                                        _sensors, ctx.hops());
+
+        // record the least hops between the sinks and all other nodes
+        // by one search, which goes no deeper than any sensor may be.
+        MaskedGraph<CSRGraph<Node>>    g(_graph, _mask);
+        _hops = hop_distances(g, _sinks, bound);
+        for (auto &s : _sensors)
+            if (_hops[s] == Vertex<Node>::DEFAULT_WEIGHT || _hops[s] > ctx.hop(s))
+                _late.push_back(s);
+        if (!_late.empty())
+            _status = solve_status::HOP_VIOLATED;
+    }
+
+    MaskedGraph<CSRGraph<Node>>
+    Problem::view(const DynamicBitset& on) const {
+        MaskedGraph<CSRGraph<Node>>    g(_graph, on);
+
+        for (size_type i = 0; i < size(); ++i)
+            if (!_mask.test(i))
+                g.deactivate(i);
+        return g;
+    }
+}
+
+#endif
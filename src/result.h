@@ -0,0 +1,113 @@
+#ifndef QOSRNP_RESULT_H
+#define QOSRNP_RESULT_H
+
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <cstdint>      // uint8_t
+
+#include "header.h"
+
+namespace qosrnp {
+    // type declarations.
+    enum class solve_status: uint8_t;
+    template <typename T> class Result;
+
+    // function declarations.
+    std::ostream& operator<<(std::ostream&, const solve_status&);
+
+    /* @enum solve_status
+     *
+     * Outcome of a search on an instance. Only OK carries a value,
+     * the others tell why there is none.
+     */
+    enum class solve_status: uint8_t {
+        OK,
+        // the source cannot reach all the destinations.
+        DISCONNECTED,
+        // some destinations are not reached within their hop budgets.
+        HOP_VIOLATED,
+        // no set of the family, or no k-set cover, covers what is left.
+        NO_COVER
+    };
+
+    std::ostream&
+    operator<<(std::ostream& os, const solve_status& s) {
+        switch (s) {
+        case solve_status::OK:
+            os << "ok";
+            break;
+        case solve_status::DISCONNECTED:
+            os << "disconnected";
+            break;
+        case solve_status::HOP_VIOLATED:
+            os << "hop violated";
+            break;
+        case solve_status::NO_COVER:
+            os << "no cover";
+            break;
+        }
+        return os;
+    }
+
+    /* @class Result
+     *
+     * Either a value of type T or the status telling why there is
+     * none, returned where failing is a routine outcome of the
+     * instance rather than a misuse, so callers branch on ok()
+     * instead of catching. Reading the value of a failed result is
+     * a misuse, and throws.
+     */
+    template <typename T>
+    class Result {
+    public:
+        typedef T            value_type;
+
+        Result(const T& v) : _status(solve_status::OK), _value(v) {}
+        Result(T&& v) : _status(solve_status::OK), _value(std::move(v)) {}
+        Result(solve_status);
+        Result(const Result&) = default;
+        Result(Result&&) = default;
+        ~Result() = default;
+
+        Result& operator=(const Result&) = default;
+        Result& operator=(Result&&) = default;
+
+        bool ok() const { return _status == solve_status::OK; }
+        explicit operator bool() const { return ok(); }
+        solve_status status() const { return _status; }
+
+        const T& value() const;
+        T& value();
+        // the value, or v if there is none.
+        T value_or(const T& v) const { return ok() ? _value : v; }
+
+    private:
+        solve_status    _status;
+        T               _value;
+    };
+
+    template <typename T>
+    Result<T>::Result(solve_status s) : _status(s), _value() {
+        if (s == solve_status::OK)
+            throw std::range_error("A result of ok status needs a value.");
+    }
+
+    template <typename T>
+    const T&
+    Result<T>::value() const {
+        if (!ok())
+            throw std::range_error("No value in a failed result.");
+        return _value;
+    }
+
+    template <typename T>
+    T&
+    Result<T>::value() {
+        if (!ok())
+            throw std::range_error("No value in a failed result.");
+        return _value;
+    }
+}
+
+#endif
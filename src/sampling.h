@@ -0,0 +1,174 @@
+#ifndef QOSRNP_SAMPLING_H
+#define QOSRNP_SAMPLING_H
+
+#include <vector>
+#include <random>
+#include <stdexcept>
+
+#include "header.h"
+
+namespace qosrnp {
+    // type declarations.
+    template <typename W> class FenwickTree;
+    class AliasTable;
+
+    /* @class FenwickTree
+     *
+     * Weights of items 0 ... n-1 in a binary indexed tree, so a
+     * weight is changed, and the first item whose prefix sum of
+     * weights reaches a given value is found, in O(log n) time. It
+     * draws items with probabilities proportional to weights that
+     * change between the draws, e.g., sizes of shrinking sets.
+     */
+    template <typename W>
+    class FenwickTree {
+    public:
+        typedef W            weight_type;
+
+        FenwickTree() : _weights(), _tree(1, 0) {}
+        explicit FenwickTree(size_type n) : _weights(n, 0), _tree(n + 1, 0) {}
+        FenwickTree(const FenwickTree&) = default;
+        FenwickTree(FenwickTree&&) = default;
+        ~FenwickTree() = default;
+
+        FenwickTree& operator=(const FenwickTree&) = default;
+        FenwickTree& operator=(FenwickTree&&) = default;
+
+        size_type size() const { return _weights.size(); }
+        const weight_type& weight(size_type i) const { return _weights[i]; }
+        weight_type total() const { return prefix(size()); }
+
+        // add to, or set, the weight of the i-th item.
+        void add(size_type, const weight_type&);
+        void set(size_type i, const weight_type& w) { add(i, w - _weights[i]); }
+        // sum of the weights of the first i items.
+        weight_type prefix(size_type) const;
+        // the first item whose prefix sum, itself included, is not
+        // less than given value, or size() if there is none.
+        size_type lower_bound(weight_type) const;
+
+    private:
+        std::vector<weight_type>    _weights;
+        // _tree[i] sums the weights of items i - (i & -i) ... i - 1.
+        std::vector<weight_type>    _tree;
+    };
+
+    template <typename W>
+    void
+    FenwickTree<W>::add(size_type i, const W& w) {
+        _weights[i] += w;
+        for (++i; i < _tree.size(); i += i & (~i + 1))
+            _tree[i] += w;
+    }
+
+    template <typename W>
+    W
+    FenwickTree<W>::prefix(size_type i) const {
+        W    sum = 0;
+        for (; i > 0; i -= i & (~i + 1))
+            sum += _tree[i];
+        return sum;
+    }
+
+    template <typename W>
+    size_type
+    FenwickTree<W>::lower_bound(W w) const {
+        size_type    pos = 0, step = 1;
+
+        if (w <= 0)
+            return 0;
+        while (step * 2 < _tree.size())
+            step *= 2;
+        // descend from the highest power of two, keeping the sum of
+        // the items before pos less than w.
+        for (; step > 0; step /= 2)
+            if (pos + step < _tree.size() && _tree[pos + step] < w) {
+                pos += step;
+                w -= _tree[pos];
+            }
+        return pos;
+    }
+
+    /* @class AliasTable
+     *
+     * Walker's alias table of fixed weights of items 0 ... n-1.
+     * Built in O(n) time, it draws an item with a probability
+     * proportional to its weight in O(1) time, using a uniform
+     * column and a uniform real number from the engine, so the
+     * draws are reproducible for a given seed.
+     */
+    class AliasTable {
+    public:
+        AliasTable() : _prob(), _alias() {}
+        explicit AliasTable(const std::vector<double>&);
+        AliasTable(const AliasTable&) = default;
+        AliasTable(AliasTable&&) = default;
+        ~AliasTable() = default;
+
+        AliasTable& operator=(const AliasTable&) = default;
+        AliasTable& operator=(AliasTable&&) = default;
+
+        size_type size() const { return _prob.size(); }
+        size_type operator()(std::default_random_engine&) const;
+
+    private:
+        // probability of keeping the item of each column, or taking
+        // the alias of that column instead.
+        std::vector<double>       _prob;
+        std::vector<size_type>    _alias;
+    };
+
+    AliasTable::AliasTable(const std::vector<double>& ws)
+    : _prob(ws.size(), 1.0), _alias(ws.size()) {
+        std::vector<size_type>    small, large;
+        std::vector<double>       scaled(ws.size());
+        double                    sum = 0.0;
+
+        for (auto &w : ws) {
+            if (w < 0.0)
+                throw std::range_error("Negative weight.");
+            sum += w;
+        }
+        if (sum <= 0.0)
+            throw std::range_error("No positive weight.");
+        for (size_type i = 0; i < ws.size(); ++i) {
+            _alias[i] = i;
+            scaled[i] = ws[i] * ws.size() / sum;
+            if (scaled[i] < 1.0)
+                small.push_back(i);
+            else
+                large.push_back(i);
+        }
+        // pair each light column with a heavy item that fills it up.
+        while (!small.empty() && !large.empty()) {
+            size_type s = small.back(), l = large.back();
+            small.pop_back();
+            _prob[s] = scaled[s];
+            _alias[s] = l;
+            scaled[l] -= 1.0 - scaled[s];
+            if (scaled[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // the rest are full up to rounding errors.
+        for (auto &i : small)
+            _prob[i] = 1.0;
+        for (auto &i : large)
+            _prob[i] = 1.0;
+    }
+
+    size_type
+    AliasTable::operator()(std::default_random_engine& en) const {
+        if (_prob.empty())
+            throw std::range_error("Empty alias table.");
+
+        std::uniform_int_distribution<size_type>    col(0, _prob.size() - 1);
+        std::uniform_real_distribution<double>      coin(0.0, 1.0);
+        size_type                                   i = col(en);
+
+        return coin(en) < _prob[i] ? i : _alias[i];
+    }
+}
+
+#endif
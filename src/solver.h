@@ -0,0 +1,111 @@
+#ifndef QOSRNP_SOLVER_H
+#define QOSRNP_SOLVER_H
+
+#include <vector>
+#include <stdexcept>
+#include <set>
+
+#include "header.h"
+#include "node.h"
+#include "graph.h"
+#include "graph_misc.h"
+#include "context.h"
+#include "problem.h"
+#include "result.h"
+#include "cover_builder.h"
+
+namespace qosrnp {
+    // function declarations.
+    template <class G, class F>
+    solve_status place_relays(const Problem&, const G&, F, int, std::set<size_type>&);
+
+    /* @fn place_relays()
+     *
+     * The steps shared by c1np, dc1np and rdc1np on graph g, which
+     * views the graph of problem pb with some relays switched off. If
+     * the sensors and the sinks alone cannot meet the hop constraints,
+     * the relays covering the sensors are placed level by level
+     * towards the nearest sinks, at most the max hop constraint plus
+     * slack levels, and cover(cvr, tmp) finds the nodes of each
+     * level covering cover instance cvr into tmp, or returns false
+     * if it finds none. The hop budgets used on the way are kept apart
+     * from pb, which is not changed.
+     * @return OK if the placed relays are given in y_hat, which is
+     *         empty if no relay is needed, or why no placement is
+     *         found.
+     */
+    template <class G, class F>
+    solve_status
+    place_relays(const Problem& pb, const G& g, F cover, int slack,
+                 std::set<size_type>& y_hat) {
+        const std::vector<size_type>&   srcs = pb.sinks();
+        const std::vector<size_type>&   dests = pb.sensors();
+        std::vector<hop_type>           budgets = pb.context().hops();
+
+        y_hat.clear();
+        // if the sensors and the sink alone meet delay constraints,
+        // no relay is needed, and if all the nodes cannot, no subset
+        // of them can.
+        if (pb.sensors_suffice())
+            return solve_status::OK;
+        if (!pb.feasible())
+            return pb.status();
+
+        if (!is_connected(g, srcs, dests))
+            return solve_status::DISCONNECTED;
+        // record the shortest distances (i.e., least hops) between
+        // the nearest sink and all other nodes, including sensors and
+        // relays, as far as a sensor may be.
+        int DELTA = max_hop(dests, budgets);
+        std::vector<hop_type> hops = hop_distances(g, srcs, DELTA);
+        if (!meet_hop(hops, dests, budgets))
+            return solve_status::HOP_VIOLATED;
+// main step begins.
+        int k = 0;
+        std::set<size_type> ik(dests.begin(), dests.end()), cvr_set;
+        // main loop.
+        while (!ik.empty()) {
+            if (++k > DELTA + slack) {
+                y_hat.clear();
+                return solve_status::NO_COVER;
+            }
+            // for each node in u, find the nodes that can be effectively
+            // covered by it from ik, i.e., its neighbors in ik whose
+            // delay constraints are met.
+            DenseCover cvr = frontier_cover(g, ik.begin(), ik.end(),
+                [&](size_type v, size_type t) {
+                    return hops[v] < budgets[t];
+                });
+            // a level nothing covers leaves the sensors behind it
+            // cut off from the sink.
+            if (!cover(cvr, cvr_set) || cvr_set.empty()) {
+                y_hat.clear();
+                return solve_status::NO_COVER;
+            }
+             // for each node in the cover update its delay constraint.
+            for (auto &e : cvr_set) {
+                const DynamicBitset& fam = cvr.family(e);
+                for (size_type p = fam.find_first(); p != DynamicBitset::NPOS;
+                     p = fam.find_next(p))
+                    if (budgets[e] > budgets[p] - 1)
+                        budgets[e] = budgets[p] - 1;
+            }
+            // record the placed relay nodes.
+            for (auto &e : cvr_set)
+                if (pb.context().node(e).type() == node_type::RELAY)
+                    y_hat.insert(e);
+            // delete the sinks and the nodes that are neighbors of
+            // them from tmp.
+            for (auto &src : srcs) {
+                cvr_set.erase(src);
+                for_each_neighbor(g, src, [&](size_type v, double) {
+                    cvr_set.erase(v);
+                });
+            }
+            ik = cvr_set;
+        }
+        return solve_status::OK;
+    }
+}
+
+#endif
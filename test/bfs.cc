@@ -0,0 +1,70 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <chrono>
+#include <vector>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/graph.h"
+#include "../src/csr_graph.h"
+#include "../src/graph_misc.h"
+#include "../src/bfs.h"
+
+std::uniform_real_distribution<double> d(0.0, 300.0);
+std::default_random_engine e(std::time(0));
+
+qosrnp::id_type   id = 0;
+
+int main() {
+    qosrnp::Nodes    nodes;
+    std::vector<qosrnp::size_type> dests;
+    qosrnp::BFSWorkspace ws;
+    int connected = 0;
+
+    for (int i = 0; i < 5000; ++i)
+        if (i < 1)
+            nodes.push_back(new qosrnp::Sink(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+        else if (i < 1001)
+            nodes.push_back(new qosrnp::Sensor(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 15, id++));
+        else
+            nodes.push_back(new qosrnp::Relay(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+    for (qosrnp::size_type i = 1; i < 1001; ++i)
+        dests.push_back(i);
+
+    qosrnp::AdjacencyList<qosrnp::Node> al(nodes.begin(), nodes.end());
+
+    // the same workspace is reused by all searches.
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i)
+        connected += qosrnp::is_connected(al, 1001 + i, dests, ws);
+    auto t1 = std::chrono::steady_clock::now();
+    std::cout << "1000 searches: " << std::chrono::duration<double>(t1 - t0).count()
+              << "s, connected " << connected << " times" << std::endl;
+
+    qosrnp::size_type reached = qosrnp::breadth_first_search(al, 0,
+        [](qosrnp::size_type, qosrnp::size_type) { return true; }, ws);
+    std::cout << "reached from sink: " << reached << std::endl;
+    std::cout << "connected graph: " << qosrnp::breadth_first_traverse(al, false, ws) << std::endl;
+
+    qosrnp::AdjacencyList<qosrnp::Node> tree = qosrnp::breadth_first_tree(al, ws);
+    qosrnp::size_type edges = 0;
+    for (auto &v : tree)
+        edges += v.size_neighbor();
+    std::cout << "tree edges: " << edges << std::endl;
+
+    // one search from many sources gives the hops to the nearest one.
+    std::vector<qosrnp::size_type> srcs{0, 1001, 2001, 3001};
+    std::vector<qosrnp::hop_type> nearest = qosrnp::hop_distances(al, srcs, 15, ws),
+                                  h(al.size(), qosrnp::Vertex<qosrnp::Node>::DEFAULT_WEIGHT);
+    for (auto &s : srcs) {
+        std::vector<qosrnp::hop_type> hs = qosrnp::hop_distances(al, s, 15, ws);
+        for (qosrnp::size_type i = 0; i < al.size(); ++i)
+            if (hs[i] < h[i])
+                h[i] = hs[i];
+    }
+    bool same = nearest == h;
+    std::cout << "multi-source hops: " << (same ? "nearest" : "different") << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <vector>
+
+#include "../src/bitset.h"
+
+int main(void) {
+    std::uniform_int_distribution<unsigned> d(0, 199);
+    std::default_random_engine e(std::time(0));
+    qosrnp::DynamicBitset    bs(200);
+    std::vector<bool>        vec(200, false);
+    bool                     same = true;
+
+    for (int i = 0; i < 100; ++i) {
+        unsigned k = d(e);
+        same = same && bs.test_and_set(k) == vec[k];
+        vec[k] = true;
+    }
+    for (int i = 0; i < 50; ++i) {
+        unsigned k = d(e);
+        bs.reset(k);
+        vec[k] = false;
+    }
+    qosrnp::size_type cnt = 0;
+    for (unsigned i = 0; i < 200; ++i) {
+        same = same && bs.test(i) == vec[i];
+        cnt += vec[i];
+    }
+    std::cout << bs << std::endl;
+    std::cout << "count: " << bs.count() << ", expected: " << cnt << std::endl;
+
+    // visit the set bits in order.
+    qosrnp::size_type nth = 0;
+    for (qosrnp::size_type i = bs.find_first(); i != qosrnp::DynamicBitset::NPOS;
+         i = bs.find_next(i), ++nth)
+        same = same && vec[i] && bs.find_nth(nth) == i;
+    same = same && nth == cnt && bs.find_nth(nth) == qosrnp::DynamicBitset::NPOS;
+    qosrnp::DynamicBitset half(200);
+    for (unsigned i = 0; i < 100; ++i)
+        half.set(i);
+    std::cout << "set beyond 100: " << bs.count_subtract(half) << ", "
+              << qosrnp::DynamicBitset(bs).subtract(half).count() << std::endl;
+    bs.resize(70);
+    std::cout << "after resized to 70: " << bs.count() << std::endl;
+    bs.clear();
+    std::cout << "after cleared: " << bs.count() << std::endl;
+    std::cout << (same ? "identical" : "different") << std::endl;
+
+    return 0;
+}
@@ -49,7 +49,13 @@ int c1np_test(void) {
 
     std::vector<qosrnp::Node*> nodes(nds.begin(), nds.end());
 
-    std::set<qosrnp::size_type> y = qosrnp::c1np(nodes);
+    qosrnp::SolveContext ctx(nodes);
+    qosrnp::Result<std::set<qosrnp::size_type>> r = qosrnp::c1np(ctx);
+    if (!r) {
+        std::cout << "no placement: " << r.status() << std::endl;
+        return 0;
+    }
+    const std::set<qosrnp::size_type>& y = r.value();
 
     std::cout << "y_hat: ";
     for (auto &e : y)
@@ -57,7 +63,8 @@ int c1np_test(void) {
     std::cout <<  std::endl;
     std::cout << "size: " << y.size() << std::endl;
 
-    qosrnp::AdjacencyList<qosrnp::Node> al(nodes.begin(), nodes.end());
+    // the relays not placed are switched off in the context.
+    qosrnp::AdjacencyList<qosrnp::Node> al = qosrnp::active_graph(ctx);
     if (!mysql.write_adjacency_list(al))
         std::cout << "mysql error!" << std::endl;
     else
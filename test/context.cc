@@ -0,0 +1,94 @@
+#include <random>
+#include <iostream>
+#include <vector>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/context.h"
+#include "../src/c1np.h"
+#include "../src/dc1np.h"
+#include "../src/rdc1np.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::default_random_engine e(1);
+qosrnp::id_type id = 0;
+
+qosrnp::Node*
+random_node(qosrnp::node_type t) {
+    switch(t) {
+    case qosrnp::node_type::SENSOR:
+        return new qosrnp::Sensor(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 15, id++);
+    case qosrnp::node_type::RELAY:
+        return new qosrnp::Relay(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++);
+    case qosrnp::node_type::SINK:
+        return new qosrnp::Sink(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++);
+    }
+    return nullptr;
+}
+
+void
+print(const char* name, const std::set<qosrnp::size_type>& y) {
+    std::cout << name << " " << y.size() << ":";
+    for (auto &i : y)
+        std::cout << " " << i;
+    std::cout << std::endl;
+}
+
+int main(void) {
+    qosrnp::Nodes nds;
+
+    for (int i = 0; i < 400; ++i) {
+        if (i < 1)
+            nds.push_back(random_node(qosrnp::node_type::SINK));
+        else if (i < 40)
+            nds.push_back(random_node(qosrnp::node_type::SENSOR));
+        else
+            nds.push_back(random_node(qosrnp::node_type::RELAY));
+    }
+    std::vector<qosrnp::Node*> nodes(nds.begin(), nds.end());
+
+    // many solves share one context, which they only read.
+    qosrnp::SolveContext ctx(nodes);
+    std::default_random_engine en1(7), en2(7);
+    print("dc1np", qosrnp::dc1np(ctx).value());
+    std::cout << "dc1np again: "
+              << (qosrnp::dc1np(ctx).value() == qosrnp::dc1np(nodes) ? "same" : "different")
+              << std::endl;
+    std::cout << "rdc1np: "
+              << (qosrnp::rdc1np(en1, ctx).value_or({}) == qosrnp::rdc1np(en2, nodes) ? "same" : "different")
+              << std::endl;
+
+    // c1np switches off the relays it does not place in the context.
+    std::set<qosrnp::size_type> y = qosrnp::c1np(ctx).value();
+    qosrnp::size_type on = 0;
+    for (qosrnp::size_type i = 0; i < ctx.size(); ++i)
+        if (ctx.node(i).type() == qosrnp::node_type::RELAY && ctx.is_active(i))
+            ++on;
+    print("c1np", y);
+    std::cout << "relays on: " << on << std::endl;
+
+    // setting the powers in a context solves as on nodes having
+    // those powers, without changing the nodes.
+    qosrnp::SolveContext strong(nodes);
+    qosrnp::Nodes copies;
+    for (qosrnp::size_type i = 0; i < strong.size(); ++i) {
+        strong.set_power(i, 20.0);
+        copies.push_back(qosrnp::copy_node(*nodes[i]));
+        copies.back()->set_power(20.0);
+    }
+    std::vector<qosrnp::Node*> strong_nodes(copies.begin(), copies.end());
+    std::cout << "dc1np at power 20: "
+              << (qosrnp::dc1np(strong).value_or({}) == qosrnp::dc1np(strong_nodes)
+                  ? "same" : "different")
+              << std::endl;
+
+    // the nodes themselves are never changed.
+    bool untouched = true;
+    for (auto &n : nodes)
+        if (n->power() != 10.0 ||
+            n->hop() != (n->type() == qosrnp::node_type::SENSOR ? 15 : 9999))
+            untouched = false;
+    std::cout << "nodes untouched: " << (untouched ? "yes" : "no") << std::endl;
+
+    return 0;
+}
@@ -47,7 +47,7 @@ int main() {
     std::cout << "random k-cover 1: " << std::endl;
     for (auto &c : cvr.random_k_set_cover(e, 3)) {
         std::cout << "set " << c << ": ";
-        for (auto &e : cvr.family()[c])
+        for (auto &e : cvr.family().at(c))
             std::cout << e << " ";
         std::cout << std::endl;
     }
@@ -55,7 +55,7 @@ int main() {
     std::cout << "random k-cover 2: " << std::endl;
     for (auto &c : tmp_cvr.random_k_set_cover(e, 3)) {
         std::cout << "set " << c << ": ";
-        for (auto &e : tmp_cvr.family()[c])
+        for (auto &e : tmp_cvr.family().at(c))
             std::cout << e << " ";
         std::cout << std::endl;
     }
@@ -0,0 +1,63 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <vector>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/graph.h"
+#include "../src/graph_misc.h"
+#include "../src/cover_builder.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::uniform_int_distribution<unsigned> h(5, 20);
+std::default_random_engine e(std::time(0));
+
+qosrnp::id_type   id = 0;
+
+int main() {
+    qosrnp::Nodes    nodes;
+    std::set<qosrnp::size_type> ik;
+
+    for (int i = 0; i < 500; ++i)
+        if (i < 1)
+            nodes.push_back(new qosrnp::Sink(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+        else if (i < 101)
+            nodes.push_back(new qosrnp::Sensor(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, h(e), id++));
+        else
+            nodes.push_back(new qosrnp::Relay(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, h(e), id++));
+    for (qosrnp::size_type i = 1; i < 101; ++i)
+        ik.insert(i);
+
+    qosrnp::AdjacencyList<qosrnp::Node> al(nodes.begin(), nodes.end());
+    qosrnp::PathTree<qosrnp::hop_type> spt = qosrnp::breadth_first_spt(al, 0);
+    auto covers = [&](qosrnp::size_type v, qosrnp::size_type t) {
+        return spt.weight[v] < al[t].node()->hop();
+    };
+
+    // the same instance as a scan of every edge in the graph.
+    qosrnp::DenseCover full(al.size());
+    for (auto &v : al)
+        for (auto &n : v.neighbors())
+            if (ik.count(n.tail()->id()) && covers(v.id(), n.tail()->id()))
+                full.insert_family(v.id(), n.tail()->id());
+    for (auto &t : ik)
+        full.insert_set(t);
+
+    qosrnp::DenseCover cvr = qosrnp::frontier_cover(al, ik.begin(), ik.end(), covers);
+    bool same = cvr.set().count() == full.set().count();
+    qosrnp::size_type sets = 0;
+    for (qosrnp::size_type v = 0; v < al.size(); ++v) {
+        same = same && cvr.has_family(v) == full.has_family(v);
+        if (same && cvr.has_family(v)) {
+            ++sets;
+            same = cvr.family(v).count() == full.family(v).count() &&
+                   cvr.family(v).count_subtract(full.family(v)) == 0;
+        }
+    }
+    std::cout << "sets: " << sets << ", " << (same ? "identical" : "different") << std::endl;
+    std::cout << "minimum cover: " << cvr.minimum_set_cover().size() << std::endl;
+
+    return 0;
+}
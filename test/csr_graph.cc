@@ -0,0 +1,78 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <vector>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/graph.h"
+#include "../src/csr_graph.h"
+#include "../src/graph_misc.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::default_random_engine e(std::time(0));
+
+qosrnp::id_type   id = 0;
+
+int main() {
+    qosrnp::Nodes    nodes;
+    std::vector<qosrnp::size_type> dests;
+    bool ok = true;
+
+    for (int i = 0; i < 500; ++i)
+        if (i < 1)
+            nodes.push_back(new qosrnp::Sink(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+        else if (i < 101)
+            nodes.push_back(new qosrnp::Sensor(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 15, id++));
+        else
+            nodes.push_back(new qosrnp::Relay(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+    for (qosrnp::size_type i = 1; i < 101; ++i)
+        dests.push_back(i);
+
+    qosrnp::AdjacencyList<qosrnp::Node> al(nodes.begin(), nodes.end());
+    qosrnp::CSRGraph<qosrnp::Node> csr(nodes.begin(), nodes.end());
+
+    for (qosrnp::size_type i = 0; i < al.size(); ++i) {
+        ok = ok && al[i].size_neighbor() == csr.degree(i);
+        for (qosrnp::size_type j = 0; ok && j < csr.degree(i); ++j)
+            ok = static_cast<qosrnp::size_type>(al[i].neighbors()[j].tail()->id()) ==
+                 *(csr.begin(i) + j);
+    }
+    std::cout << "edges: " << csr.edges() << ", "
+              << (ok ? "identical" : "different") << std::endl;
+    {
+        qosrnp::AdjacencyList<qosrnp::Node> qal(nodes.begin(), nodes.end(), qosrnp::build_mode::GRID,
+                                                qosrnp::QUALITY_CONSTRAINT);
+        qosrnp::CSRGraph<qosrnp::Node> qcsr(nodes.begin(), nodes.end(), qosrnp::build_mode::GRID,
+                                            qosrnp::QUALITY_CONSTRAINT);
+        bool same = qcsr.edges() == qosrnp::CSRGraph<qosrnp::Node>(qal).edges();
+        for (qosrnp::size_type i = 0; same && i < qal.size(); ++i)
+            for (qosrnp::size_type j = 0; same && j < qcsr.degree(i); ++j)
+                same = qal[i].neighbors()[j].weight() == qcsr.weight(qcsr.offset(i) + j);
+        std::cout << "edges under quality constraint: " << qcsr.edges() << ", "
+                  << (same ? "identical" : "different") << std::endl;
+    }
+    std::cout << "bytes per edge: adjacency list " << sizeof(qosrnp::Edge<qosrnp::Node>)
+              << ", csr " << sizeof(qosrnp::CSRGraph<qosrnp::Node>::index_type) << std::endl;
+
+    std::cout << "connected: " << qosrnp::breadth_first_traverse(al, false)
+              << " / " << qosrnp::breadth_first_traverse(csr, false) << std::endl;
+    std::cout << "sink connects sensors: " << qosrnp::is_connected(al, 0, dests)
+              << " / " << qosrnp::is_connected(csr, 0, dests) << std::endl;
+
+    try {
+        qosrnp::AdjacencyList<qosrnp::Node> spt = qosrnp::dijkstra_spt(al, 0, dests);
+        auto tree = qosrnp::dijkstra_spt(csr, 0, dests).value();
+        ok = true;
+        for (qosrnp::size_type i = 0; i < al.size(); ++i) {
+            ok = ok && al[i].weight() == tree.weight[i];
+            if (spt[i].parent() != qosrnp::Vertex<qosrnp::Node>::DEFAULT_PARENT)
+                ok = ok && spt[i].parent() == tree.parent[i];
+        }
+        std::cout << "spt: " << (ok ? "identical" : "different") << std::endl;
+    } catch (const std::range_error& err) {
+        std::cout << err.what() << std::endl;
+    }
+
+    return 0;
+}
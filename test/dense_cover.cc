@@ -0,0 +1,62 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <vector>
+
+#include "../src/cover.h"
+#include "../src/dense_cover.h"
+
+int main() {
+    std::uniform_int_distribution<unsigned> u(0, 399);
+    std::uniform_int_distribution<unsigned> s(10, 20);
+    std::uniform_int_distribution<unsigned> ss(0, 20);
+    std::uniform_int_distribution<unsigned> f(20, 50);
+    std::default_random_engine e(std::time(0));
+    qosrnp::Cover<qosrnp::size_type, qosrnp::size_type> cvr;
+    qosrnp::DenseCover     dcvr(400);
+    std::vector<int>       vec;
+    int tmp;
+
+    for (int i = 0, n = s(e); i < n; ++i) {
+        tmp = u(e);
+        cvr.insert_set(tmp);
+        dcvr.insert_set(tmp);
+        vec.push_back(tmp);
+    }
+
+    std::uniform_int_distribution<unsigned> num(0, vec.size() - 1);
+    for (int i = 0, n = f(e); i < n; ++i)
+       for (int j = 0, k = ss(e); j < k; ++j) {
+           tmp = vec[num(e)];
+           cvr.insert_family(i, tmp);
+           dcvr.insert_family(i, tmp);
+       }
+
+    std::cout << "set: " << dcvr.set() << std::endl;
+    std::cout << "min: ";
+    for (auto &c : dcvr.minimum_set_cover())
+        std::cout << c << ",";
+    std::cout << std::endl;
+    std::cout << "same min: " << (cvr.minimum_set_cover() == dcvr.minimum_set_cover())
+              << std::endl;
+
+    // the same engine state gives the same random k-cover.
+    std::default_random_engine e1(e), e2(e);
+    std::set<qosrnp::size_type> k1 = cvr.random_k_set_cover(e1, 3),
+                                k2 = dcvr.random_k_set_cover(e2, 3);
+    bool same = k1 == k2;
+    for (auto &c : k1) {
+        std::cout << "set " << c << ": ";
+        const qosrnp::DynamicBitset& fam = dcvr.family(c);
+        for (qosrnp::size_type i = fam.find_first(); i != qosrnp::DynamicBitset::NPOS;
+             i = fam.find_next(i)) {
+            std::cout << i << " ";
+            same = same && cvr.family().at(c).count(i);
+        }
+        same = same && fam.count() == cvr.family().at(c).size();
+        std::cout << std::endl;
+    }
+    std::cout << "same random k-cover: " << same << std::endl;
+
+    return 0;
+}
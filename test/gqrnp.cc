@@ -39,6 +39,7 @@ int c1np_test(void) {
 
     mysql.query("DELETE FROM graph");
     
+    id = 0;
     for (int i = 0; i < qosrnp::sink_num + qosrnp::sensor_num + qosrnp::relay_num; ++i) {
         if (i < qosrnp::sink_num) 
             nds.push_back(random_node(qosrnp::node_type::SINK));
@@ -54,31 +55,124 @@ int c1np_test(void) {
     std::cout << "dc1np size: " << y.size() << std::endl;
     }
 
-    for (auto &n : nds) {
-        n->set_power(qosrnp::power);
-        if (n->type() == qosrnp::node_type::SENSOR)
-            n->set_hop(qosrnp::hop_constraint);
-        else 
-            n->set_hop(9999);
-    }
+    return 0;
+}
 
-/*    std::cout << "y_hat: ";
-    for (auto &e : y)
-        std::cout << e << ", ";
-    std::cout <<  std::endl;*/
-    
+void
+print(const char* name, const qosrnp::GAResult& r) {
+    std::cout << name << ": size " << r.relays.size() << ", stopped by "
+              << r.reason << " after " << r.generations << " generations"
+              << std::endl;
+}
+
+/* run gqrnp on an instance needing relays, whose sensors reach no
+ * sink by themselves at power 10, and stop it on each condition.
+ */
+int ga_test(void) {
+    qosrnp::Nodes nds;
+    double power = qosrnp::power;
+
+    qosrnp::power = 10.0;
+    e.seed(3);
+    id = 0;
+    for (int i = 0; i < 501; ++i)
+        nds.push_back(random_node(i < 1 ? qosrnp::node_type::SINK :
+                                  i < 101 ? qosrnp::node_type::SENSOR
+                                          : qosrnp::node_type::RELAY));
+    std::vector<qosrnp::Node*> nodes(nds.begin(), nds.end());
+
+    // the children are bred on threads, each from its own engine, so
+    // the number of threads never changes the result.
+    qosrnp::GAOptions opts;
+    opts.generations = 30;
+    opts.verbose = false;
+    std::default_random_engine en1(5), en4(5);
+    qosrnp::GAResult r1 = qosrnp::gqrnp(en1, nodes, opts);
+    opts.threads = 4;
+    qosrnp::GAResult r4 = qosrnp::gqrnp(en4, nodes, opts);
+    print("gqrnp on 1 thread", r1);
+    print("gqrnp on 4 threads", r4);
+    std::cout << "threads 1 and 4: "
+              << (r1.relays == r4.relays && r1.generations == r4.generations
+                  ? "same" : "different") << std::endl;
+
+    // each stop condition ends a run of 200 generations early.
+    qosrnp::GAOptions stall;
+    stall.stall_generations = 3;
+    stall.verbose = false;
+    std::default_random_engine en(5);
+    print("stall 3", qosrnp::gqrnp(en, nodes, stall));
+
+    qosrnp::GAOptions budget;
+    budget.time_budget = 1e-6;
+    budget.verbose = false;
+    print("time budget 1 us", qosrnp::gqrnp(en, nodes, budget));
+
+    qosrnp::GAOptions target;
+    target.target_size = r1.relays.size() + 5;
+    target.verbose = false;
+    print("target size", qosrnp::gqrnp(en, nodes, target));
+
+    // no run is needed when the sensors alone meet the constraints at
+    // the power of the run, or when some cannot with every relay on.
+    qosrnp::power = 30.0;
+    print("power 30", qosrnp::gqrnp(en, nodes, opts));
+    qosrnp::power = 10.0;
+
+    nodes[1]->set_coordinate(qosrnp::Coordinate(1000.0, 1000.0, 0.0));
+    qosrnp::GAResult r = qosrnp::gqrnp(en, nodes, opts);
+    print("lost sensor", r);
+    std::cout << "late sensors:";
+    for (auto &s : r.late)
+        std::cout << " " << s;
+    std::cout << std::endl;
+
+    qosrnp::power = power;
+    return 0;
+}
+
+/* breed 20 generations of an instance needing relays, whose
+ * population must keep its size.
+ */
+int evolution_test(void) {
+    qosrnp::Nodes nds;
+    double power = qosrnp::power;
+
+    qosrnp::power = 10.0;
+    e.seed(3);
+    id = 0;
+    for (int i = 0; i < 501; ++i)
+        nds.push_back(random_node(i < 1 ? qosrnp::node_type::SINK :
+                                  i < 101 ? qosrnp::node_type::SENSOR
+                                          : qosrnp::node_type::RELAY));
     std::vector<qosrnp::Node*> nodes(nds.begin(), nds.end());
-/*    for (auto &n : nodes)
-        std::cout << "hop: " << n->hop()
-                  << ", power: " << n->power() << std::endl;
-*/
-    std::set<qosrnp::size_type> y = qosrnp::gqrnp(e, nodes);
-    std::cout << "gqrnp size: " << y.size() << std::endl;
+    qosrnp::Problem pb = qosrnp::ga_problem(nodes);
+    qosrnp::GAOptions opts;
+    qosrnp::Evolution evo(pb, opts);
+
+    qosrnp::solve_status st = evo.seed(e);
+    std::cout << "population sizes:";
+    for (int g = 0; g < 20 && st == qosrnp::solve_status::OK; ++g)
+        if ((st = evo.breed(e)) == qosrnp::solve_status::OK && g % 5 == 4)
+            std::cout << " " << evo.population().size();
+    std::cout << ", " << st << std::endl;
+    // parents converge, so the pools of dc1np children repeat.
+    std::cout << "dc1np cache hits: " << evo.cache().hits()
+              << ", misses: " << evo.cache().misses() << std::endl;
 
+    // a chromosome placing more relays than the candidates is not fit
+    // at all, rather than the fittest.
+    std::cout << "fitness of 450 relays out of 400: " << qosrnp::fitness(450, 400)
+              << std::endl;
+    qosrnp::power = power;
     return 0;
 }
 
 int main(void) {
+    // the GA tests need no database, so they run before c1np_test(),
+    // which stops if none is available.
+    ga_test();
+    evolution_test();
     c1np_test();
     return 0;
 }
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <random>
 #include <ctime>
+#include <vector>
 
 #include "../src/header.h"
 #include "../src/node.h"
@@ -68,6 +69,31 @@ int main() {
 
     qosrnp::AdjacencyList<qosrnp::Node> al(nodes.begin(), nodes.end());
 
+    // switch every other relay off in place, and compare with
+    // a graph built with these relays having no power.
+    {
+        qosrnp::AdjacencyList<qosrnp::Node> tmp(al);
+        std::vector<qosrnp::Node::power_type> powers;
+        bool same = true;
+        for (int i = 100; i < 400; i += 2) {
+            tmp.deactivate(i);
+            powers.push_back(nodes[i]->power());
+            nodes[i]->set_power(0.0);
+        }
+        tmp.reactivate(150); tmp.deactivate(150);
+        tmp.deactivate(151); tmp.reactivate(151);
+        qosrnp::AdjacencyList<qosrnp::Node> off(nodes.begin(), nodes.end());
+        for (int i = 0; i < 400; ++i) {
+            same = same && tmp[i].size_neighbor() == off[i].size_neighbor();
+            for (qosrnp::size_type j = 0; same && j < off[i].size_neighbor(); ++j)
+                same = tmp[i].neighbors()[j].tail()->id() ==
+                       off[i].neighbors()[j].tail()->id();
+        }
+        for (int i = 100, k = 0; i < 400; i += 2)
+            nodes[i]->set_power(powers[k++]);
+        std::cout << "deactivate: " << (same ? "identical" : "different") << std::endl;
+    }
+
     if (!mysql.write_adjacency_list(al))
         std::cout << "mysql error!" << std::endl;
     else
@@ -2,6 +2,9 @@
 #include <random>
 #include <ctime>
 #include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
 
 #include "../src/header.h"
 #include "../src/graph_misc.h"
@@ -48,6 +51,69 @@ random_node(qosrnp::node_type t) {
     return nullptr;
 }
 
+/* cheapest cost from src to each vertex over walks of at most h hops,
+ * for each h in [0, max_hops], by relaxing every edge once per hop.
+ */
+std::vector<std::vector<double>>
+bounded_costs(const qosrnp::AdjacencyList<qosrnp::Node>& g, qosrnp::size_type src,
+              qosrnp::hop_type max_hops) {
+    std::vector<std::vector<double>> c(max_hops + 1,
+        std::vector<double>(g.size(), std::numeric_limits<double>::infinity()));
+
+    c[0][src] = 0.0;
+    for (qosrnp::hop_type k = 1; k <= max_hops; ++k) {
+        c[k] = c[k - 1];
+        for (qosrnp::size_type u = 0; u < g.size(); ++u)
+            qosrnp::for_each_neighbor(g, u, [&](qosrnp::size_type v, double w) {
+                c[k][v] = std::min(c[k][v], c[k - 1][u] + w);
+            });
+    }
+    return c;
+}
+
+/* check the tree of weighted_spt() within max_hops against
+ * bounded_costs(): the cost, the fewest hops at that cost, and a
+ * parent linked to the vertex through which that cost is met.
+ * @return number of vertices whose cheapest path takes more than
+ * max_hops, but which are reached within max_hops.
+ */
+qosrnp::size_type
+check_weighted_spt(const qosrnp::AdjacencyList<qosrnp::Node>& g,
+                   qosrnp::hop_type max_hops, bool& ok) {
+    const double                    eps = 1e-9;
+    std::vector<qosrnp::hop_type>   hops;
+    qosrnp::PathTree<double>        spt = qosrnp::weighted_spt(g, 0, hops, max_hops);
+    auto                            c = bounded_costs(g, 0,
+        std::max(max_hops, static_cast<qosrnp::hop_type>(g.size() - 1)));
+    qosrnp::size_type               detours = 0;
+
+    for (qosrnp::size_type v = 0; v < g.size(); ++v) {
+        double best = c[max_hops][v];
+        if (best == std::numeric_limits<double>::infinity()) {
+            ok = ok && hops[v] == qosrnp::Vertex<qosrnp::Node>::DEFAULT_WEIGHT &&
+                 spt.parent[v] == qosrnp::Vertex<qosrnp::Node>::DEFAULT_PARENT;
+            continue;
+        }
+        qosrnp::hop_type fewest = 0;
+        while (c[fewest][v] > best + eps)
+            ++fewest;
+        ok = ok && std::abs(spt.weight[v] - best) < eps && hops[v] == fewest;
+        if (v == 0 || spt.parent[v] == qosrnp::Vertex<qosrnp::Node>::DEFAULT_PARENT) {
+            ok = ok && v == 0;
+            continue;
+        }
+        bool linked = false;
+        qosrnp::for_each_neighbor(g, spt.parent[v], [&](qosrnp::size_type x, double w) {
+            if (x == v && std::abs(c[fewest - 1][spt.parent[v]] + w - best) < eps)
+                linked = true;
+        });
+        ok = ok && linked;
+        if (c[g.size() - 1][v] < best - eps)
+            ++detours;
+    }
+    return detours;
+}
+
 int main() {
     qosrnp::Nodes    nodes;
     char user[] = "root";
@@ -68,6 +134,65 @@ int main() {
     
     qosrnp::AdjacencyList<qosrnp::Node> al(nodes.begin(), nodes.end());
 
+    // with unit costs, Dial's bucket queue finds the same hops
+    // as a breadth first search.
+    {
+        qosrnp::PathTree<qosrnp::hop_type> bfs = qosrnp::breadth_first_spt(al, 0);
+        qosrnp::PathTree<qosrnp::hop_type> dial = qosrnp::dial_spt(al, 0);
+        std::cout << "dial: " << (bfs.weight == dial.weight ? "identical" : "different")
+                  << std::endl;
+    }
+
+    // without link qualities, the weighted tree finds the same hops
+    // too. Under the quality constraint, links are fewer and cost
+    // no less than one transmission each.
+    {
+        std::vector<qosrnp::hop_type> hops;
+        qosrnp::PathTree<qosrnp::hop_type> bfs = qosrnp::breadth_first_spt(al, 0);
+        qosrnp::weighted_spt(al, 0, hops);
+        std::cout << "weighted: " << (bfs.weight == hops ? "identical" : "different")
+                  << std::endl;
+    }
+
+    // under a quality constraint, links of a connected instance are
+    // fewer and cost no less than one transmission each. The
+    // constraint is loose enough that a cheaper path of more hops
+    // often exists, and the tree within a hop bound must match the
+    // costs of bounded_costs(), also for vertices whose cheapest path
+    // takes more hops than the bound.
+    {
+        std::default_random_engine      qe(1);
+        std::uniform_real_distribution<double> qd(0.0, 30.0);
+        qosrnp::Nodes                   qnodes;
+
+        for (qosrnp::id_type i = 0; i < 60; ++i)
+            qnodes.push_back(new qosrnp::Relay(qosrnp::Coordinate(qd(qe), qd(qe), 0.0),
+                                               10.0, qosrnp::hop_constraint, i));
+        qosrnp::AdjacencyList<qosrnp::Node> any(qnodes.begin(), qnodes.end());
+        qosrnp::AdjacencyList<qosrnp::Node> qal(qnodes.begin(), qnodes.end(),
+                                                qosrnp::build_mode::GRID,
+                                                0.5);
+        std::vector<qosrnp::size_type> others;
+        qosrnp::size_type links = 0, qlinks = 0;
+        for (qosrnp::size_type i = 0; i < qal.size(); ++i) {
+            if (i > 0)
+                others.push_back(i);
+            qosrnp::for_each_neighbor(any, i, [&](qosrnp::size_type, double) { ++links; });
+            qosrnp::for_each_neighbor(qal, i, [&](qosrnp::size_type, double) { ++qlinks; });
+        }
+        std::cout << "quality graph: " << (qosrnp::is_connected(qal, 0, others) ? "connected"
+                                                                            : "disconnected")
+                  << ", " << links / 2 - qlinks / 2 << " links dropped" << std::endl;
+
+        bool              ok = true;
+        qosrnp::size_type detours = 0;
+        for (qosrnp::hop_type mh : {1, 2, 3, 4, 6, 8, 15, 100})
+            detours += check_weighted_spt(qal, mh, ok);
+        std::cout << "weighted within hops: " << (ok ? "exact" : "wrong")
+                  << ", " << (detours > 0 ? "bound binds" : "bound never binds")
+                  << std::endl;
+    }
+
     if (!mysql.write_adjacency_list(qosrnp::dijkstra_spt(al, 0, std::vector<qosrnp::size_type>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10})))
         std::cout << "mysql error!" << std::endl;
     else
@@ -0,0 +1,58 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <chrono>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/graph.h"
+
+std::uniform_real_distribution<double> d(0.0, 1000.0);
+std::uniform_real_distribution<double> p(0.0, 20.0);
+std::default_random_engine e(std::time(0));
+
+qosrnp::id_type   id = 0;
+
+bool
+same_edges(const qosrnp::AdjacencyList<qosrnp::Node>& a,
+           const qosrnp::AdjacencyList<qosrnp::Node>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (qosrnp::size_type i = 0; i < a.size(); ++i) {
+        if (a[i].size_neighbor() != b[i].size_neighbor())
+            return false;
+        for (qosrnp::size_type j = 0; j < a[i].size_neighbor(); ++j)
+            if (a[i].neighbors()[j].tail()->id() !=
+                b[i].neighbors()[j].tail()->id())
+                return false;
+    }
+    return true;
+}
+
+int main() {
+    qosrnp::Nodes    nodes;
+
+    for (int i = 0; i < 5000; ++i)
+        if (i < 10)
+            nodes.push_back(new qosrnp::Sink(qosrnp::Coordinate(d(e), d(e), 0.0), p(e), 9999, id++));
+        else if (i < 1000)
+            nodes.push_back(new qosrnp::Sensor(qosrnp::Coordinate(d(e), d(e), 0.0), p(e), 15, id++));
+        else
+            nodes.push_back(new qosrnp::Relay(qosrnp::Coordinate(d(e), d(e), 0.0), p(e), 9999, id++));
+
+    auto t0 = std::chrono::steady_clock::now();
+    qosrnp::AdjacencyList<qosrnp::Node> brute(nodes.begin(), nodes.end(),
+                                              qosrnp::build_mode::BRUTE_FORCE);
+    auto t1 = std::chrono::steady_clock::now();
+    qosrnp::AdjacencyList<qosrnp::Node> grid(nodes.begin(), nodes.end(),
+                                             qosrnp::build_mode::GRID);
+    auto t2 = std::chrono::steady_clock::now();
+
+    std::cout << "brute force: "
+              << std::chrono::duration<double>(t1 - t0).count() << "s, "
+              << "grid: "
+              << std::chrono::duration<double>(t2 - t1).count() << "s" << std::endl;
+    std::cout << (same_edges(brute, grid) ? "identical" : "different") << std::endl;
+
+    return 0;
+}
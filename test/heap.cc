@@ -0,0 +1,47 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+
+#include "../src/heap.h"
+
+int main(void) {
+    std::uniform_int_distribution<int> d(0, 9999);
+    std::default_random_engine e(std::time(0));
+    qosrnp::IndexedHeap<int>    heap(1000);
+    std::vector<int>            keys(1000), sorted;
+    bool                        same = true;
+
+    for (qosrnp::size_type i = 0; i < keys.size(); ++i) {
+        keys[i] = d(e);
+        heap.push(i, keys[i]);
+    }
+    // decrease the keys of half the items.
+    for (qosrnp::size_type i = 0; i < keys.size(); i += 2) {
+        keys[i] -= d(e);
+        heap.push_or_decrease(i, keys[i]);
+    }
+    // a greater key leaves an item as it is.
+    heap.push_or_decrease(1, keys[1] + 1);
+    std::cout << "size: " << heap.size() << std::endl;
+
+    sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    for (qosrnp::size_type i = 0; i < sorted.size(); ++i) {
+        qosrnp::size_type k = heap.pop();
+        same = same && heap.key(k) == sorted[i] && !heap.contains(k);
+    }
+    std::cout << "pop order: " << (same ? "sorted" : "unsorted") << std::endl;
+
+    try {
+        heap.push(0, 0);
+        heap.decrease(0, 1);
+    } catch (std::range_error err) {
+        std::cout << err.what() << std::endl;
+    }
+    heap.clear();
+    std::cout << "after cleared: " << heap.size() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <sstream>
+#include <random>
+#include <chrono>
+#include <vector>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/csr_graph.h"
+#include "../src/graph_misc.h"
+#include "../src/hop_matrix.h"
+
+std::uniform_real_distribution<double> d(0.0, 200.0);
+std::default_random_engine e(1);
+
+qosrnp::id_type   id = 0;
+
+int main() {
+    std::vector<qosrnp::Node*>    nodes;
+
+    for (int i = 0; i < 3000; ++i)
+        if (i < 3)
+            nodes.push_back(new qosrnp::Sink(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+        else if (i < 503)
+            nodes.push_back(new qosrnp::Sensor(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 15, id++));
+        else
+            nodes.push_back(new qosrnp::Relay(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+
+    qosrnp::CSRGraph<qosrnp::Node> g(nodes.begin(), nodes.end());
+
+    auto t0 = std::chrono::steady_clock::now();
+    qosrnp::HopMatrix m(g, 16, 4);
+    auto t1 = std::chrono::steady_clock::now();
+    std::cout << "matrix of " << m.size() << " vertices: " << m.bytes() << " bytes, "
+              << std::chrono::duration<double>(t1 - t0).count() << "s" << std::endl;
+
+    // every entry is the hops of a search, capped.
+    bool same = true;
+    for (qosrnp::size_type u = 0; u < g.size(); u += 7) {
+        std::vector<qosrnp::hop_type> hops = qosrnp::hop_distances(g, u);
+        for (qosrnp::size_type v = 0; v < g.size(); ++v)
+            same = same && m.hop(u, v) == std::min<qosrnp::hop_type>(hops[v], m.cap());
+    }
+    std::cout << "hops: " << (same ? "identical" : "different") << std::endl;
+
+    std::vector<qosrnp::size_type> sinks{0, 1, 2};
+    std::vector<qosrnp::hop_type> nearest = qosrnp::hop_distances(g, sinks, 15);
+    same = true;
+    for (qosrnp::size_type v = 0; v < g.size(); ++v)
+        same = same && m.nearest(sinks, v) == std::min<qosrnp::hop_type>(nearest[v], m.cap());
+    std::cout << "nearest sink: " << (same ? "identical" : "different") << std::endl;
+
+    std::vector<qosrnp::size_type> sensors;
+    std::vector<qosrnp::hop_type> budgets(g.size(), 15);
+    for (qosrnp::size_type i = 3; i < 503; ++i)
+        sensors.push_back(i);
+    std::cout << "sensors meet 15 hops: " << qosrnp::meet_hop(m, sinks, sensors, budgets)
+              << " / " << (qosrnp::is_connected(g, sinks, sensors) &&
+                           qosrnp::meet_hop(nearest, sensors, budgets)) << std::endl;
+
+    // a saved matrix loads back the same, and garbage is refused.
+    std::stringstream ss;
+    qosrnp::HopMatrix loaded;
+    m.save(ss);
+    std::cout << "loaded: " << loaded.load(ss) << ", "
+              << (loaded == m ? "same" : "different") << std::endl;
+    std::stringstream bad("not a matrix");
+    std::cout << "garbage loaded: " << loaded.load(bad) << ", "
+              << (loaded == m ? "kept" : "changed") << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <vector>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/csr_graph.h"
+#include "../src/graph_misc.h"
+#include "../src/hop_reach.h"
+
+std::uniform_real_distribution<double> d(0.0, 300.0);
+std::default_random_engine e(1);
+
+qosrnp::id_type   id = 0;
+
+int main() {
+    std::vector<qosrnp::Node*>        nodes;
+    std::vector<qosrnp::size_type>    sensors;
+
+    for (int i = 0; i < 5000; ++i)
+        if (i < 1)
+            nodes.push_back(new qosrnp::Sink(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+        else if (i < 1001)
+            nodes.push_back(new qosrnp::Sensor(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 15, id++));
+        else
+            nodes.push_back(new qosrnp::Relay(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+    for (qosrnp::size_type i = 1; i < 1001; ++i)
+        sensors.push_back(i);
+
+    qosrnp::CSRGraph<qosrnp::Node> g(nodes.begin(), nodes.end());
+
+    // 1000 sensors are searched 64 at a time.
+    auto t0 = std::chrono::steady_clock::now();
+    qosrnp::HopReach reach(g, sensors, 15, 4);
+    auto t1 = std::chrono::steady_clock::now();
+    std::vector<std::vector<qosrnp::hop_type>> hops;
+    for (auto &s : sensors)
+        hops.push_back(qosrnp::hop_distances(g, s, 15));
+    auto t2 = std::chrono::steady_clock::now();
+    std::cout << "bit-parallel: " << std::chrono::duration<double>(t1 - t0).count()
+              << "s, one search per sensor: "
+              << std::chrono::duration<double>(t2 - t1).count() << "s" << std::endl;
+
+    bool same = true;
+    for (qosrnp::size_type i = 0; i < sensors.size(); ++i)
+        for (qosrnp::size_type v = 0; v < g.size(); ++v)
+            same = same && reach.within(i, v) ==
+                   (hops[i][v] != qosrnp::Vertex<qosrnp::Node>::DEFAULT_WEIGHT);
+    std::cout << "within 15 hops: " << (same ? "identical" : "different") << std::endl;
+
+    qosrnp::size_type v = 2000;
+    std::cout << "sensors reaching " << v << ": " << reach.count(v)
+              << " / " << reach.reached_by(v).count() << std::endl;
+    std::cout << "reach of sensor 0: " << reach.reach(0).count() << std::endl;
+
+    return 0;
+}
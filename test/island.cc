@@ -0,0 +1,63 @@
+#include <random>
+#include <iostream>
+#include <vector>
+#include <set>
+#include <thread>
+
+#include "../src/header.h"
+#include "../src/island.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::default_random_engine e(3);
+qosrnp::id_type id = 0;
+
+void
+print(const qosrnp::GAResult& r) {
+    std::cout << "size " << r.relays.size() << ":";
+    for (auto &i : r.relays)
+        std::cout << " " << i;
+    std::cout << ", stopped by " << r.reason << " after "
+              << r.generations << " generations" << std::endl;
+}
+
+int main(void) {
+    std::vector<qosrnp::Node*> nodes;
+
+    nodes.push_back(new qosrnp::Sink(qosrnp::Coordinate(50.0, 50.0, 0.0), 20.0, 9999, id++));
+    for (int i = 0; i < 50; ++i)
+        nodes.push_back(new qosrnp::Sensor(qosrnp::Coordinate(d(e), d(e), 0.0), 20.0, 15, id++));
+    for (int i = 0; i < 150; ++i)
+        nodes.push_back(new qosrnp::Relay(qosrnp::Coordinate(d(e), d(e), 0.0), 20.0, 9999, id++));
+
+    // the letters of a mailbox are fetched in the order they are posted.
+    qosrnp::Mailbox box;
+    bool ordered = true;
+    std::thread sender([&]() {
+        for (qosrnp::size_type k = 0; k < 100; ++k) {
+            qosrnp::DynamicBitset letter(100);
+            letter.set(k);
+            box.post(letter);
+        }
+    });
+    for (qosrnp::size_type k = 0; k < 100; ++k) {
+        qosrnp::DynamicBitset letter;
+        box.fetch(letter);
+        ordered = ordered && letter.find_first() == k;
+    }
+    sender.join();
+    std::cout << "mailbox: " << (ordered ? "in order" : "out of order") << std::endl;
+
+    // four islands exchanging their optima every 5 generations, each
+    // stopping after 15 generations without improvement.
+    qosrnp::GAOptions opts;
+    opts.stall_generations = 15;
+    opts.verbose = false;
+    std::default_random_engine en1(5), en2(5);
+    qosrnp::GAResult r1 = qosrnp::island_gqrnp(en1, nodes, opts, 4, 5);
+    qosrnp::GAResult r2 = qosrnp::island_gqrnp(en2, nodes, opts, 4, 5);
+    print(r1);
+    std::cout << "same seed: " << (r1.relays == r2.relays ? "same" : "different")
+              << std::endl;
+
+    return 0;
+}
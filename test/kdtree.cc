@@ -0,0 +1,86 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/graph.h"
+#include "../src/kdtree.h"
+
+std::uniform_real_distribution<double> d(0.0, 1000.0);
+std::uniform_real_distribution<double> c(0.0, 50.0);
+std::uniform_real_distribution<double> p(0.0, 30.0);
+std::uniform_int_distribution<unsigned> u(0, 9);
+std::default_random_engine e(std::time(0));
+
+qosrnp::id_type   id = 0;
+
+// most nodes are packed into a few clusters, the rest are
+// scattered over the whole field.
+qosrnp::Coordinate
+random_coordinate() {
+    static const double cx[] = {100.0, 700.0, 400.0};
+    static const double cy[] = {100.0, 300.0, 900.0};
+    unsigned k = u(e);
+    if (k < 3)
+        return qosrnp::Coordinate(d(e), d(e), 0.0);
+    return qosrnp::Coordinate(cx[k % 3] + c(e), cy[k % 3] + c(e), 0.0);
+}
+
+int main() {
+    qosrnp::Nodes    nodes;
+    qosrnp::Coordinate q(500.0, 500.0, 0.0);
+    std::vector<qosrnp::size_type> res, brute;
+    bool ok = true;
+
+    for (int i = 0; i < 3000; ++i)
+        nodes.push_back(new qosrnp::Relay(random_coordinate(), p(e), 9999, id++));
+
+    qosrnp::KDTree<qosrnp::Node, 2> tree(nodes.begin(), nodes.end());
+
+    // radius query.
+    for (int t = 0; t < 100; ++t) {
+        qosrnp::Coordinate x = random_coordinate();
+        res.clear(); brute.clear();
+        tree.radius(x, 40.0, res);
+        for (qosrnp::size_type i = 0; i < nodes.size(); ++i)
+            if (qosrnp::distance(x, nodes[i]->coordinate()) <= 40.0)
+                brute.push_back(i);
+        std::sort(res.begin(), res.end());
+        ok = ok && res == brute;
+    }
+    std::cout << "radius: " << (ok ? "identical" : "different") << std::endl;
+
+    // k nearest query.
+    res = tree.nearest(q, 5);
+    std::cout << "5 nearest to " << q << ": ";
+    for (auto &i : res)
+        std::cout << i << "(" << qosrnp::distance(q, nodes[i]->coordinate()) << ") ";
+    std::cout << std::endl;
+
+    // all pairs within r.
+    qosrnp::size_type pairs = 0, brute_pairs = 0;
+    tree.pairs_within(10.0, [&](qosrnp::size_type, qosrnp::size_type) { ++pairs; });
+    for (qosrnp::size_type i = 0; i < nodes.size(); ++i)
+        for (qosrnp::size_type j = i + 1; j < nodes.size(); ++j)
+            if (qosrnp::distance(*nodes[i], *nodes[j]) <= 10.0)
+                ++brute_pairs;
+    std::cout << "pairs: " << pairs << ", brute force: " << brute_pairs << std::endl;
+
+    // graph construction.
+    qosrnp::AdjacencyList<qosrnp::Node> al1(nodes.begin(), nodes.end(),
+                                            qosrnp::build_mode::BRUTE_FORCE);
+    qosrnp::AdjacencyList<qosrnp::Node> al2(nodes.begin(), nodes.end(),
+                                            qosrnp::build_mode::KD_TREE);
+    ok = true;
+    for (qosrnp::size_type i = 0; i < al1.size(); ++i) {
+        ok = ok && al1[i].size_neighbor() == al2[i].size_neighbor();
+        for (qosrnp::size_type j = 0; ok && j < al1[i].size_neighbor(); ++j)
+            ok = al1[i].neighbors()[j].tail()->id() == al2[i].neighbors()[j].tail()->id();
+    }
+    std::cout << "graph: " << (ok ? "identical" : "different") << std::endl;
+
+    return 0;
+}
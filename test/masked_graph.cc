@@ -0,0 +1,81 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <vector>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/graph.h"
+#include "../src/csr_graph.h"
+#include "../src/masked_graph.h"
+#include "../src/graph_misc.h"
+#include "../src/cover_builder.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::default_random_engine e(std::time(0));
+
+qosrnp::id_type   id = 0;
+
+int main() {
+    qosrnp::Nodes    nodes;
+    std::vector<qosrnp::size_type> dests;
+
+    for (int i = 0; i < 500; ++i)
+        if (i < 1)
+            nodes.push_back(new qosrnp::Sink(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+        else if (i < 101)
+            nodes.push_back(new qosrnp::Sensor(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 15, id++));
+        else
+            nodes.push_back(new qosrnp::Relay(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++));
+    for (qosrnp::size_type i = 1; i < 101; ++i)
+        dests.push_back(i);
+
+    qosrnp::CSRGraph<qosrnp::Node> csr(nodes.begin(), nodes.end());
+    qosrnp::MaskedGraph<qosrnp::CSRGraph<qosrnp::Node>> view(csr);
+    qosrnp::AdjacencyList<qosrnp::Node> al(nodes.begin(), nodes.end());
+
+    // switch off every third relay in the view and in the adjacency
+    // list, which then have the same edges.
+    for (qosrnp::size_type i = 101; i < 500; i += 3) {
+        view.deactivate(i);
+        al.deactivate(i);
+    }
+    bool same = true;
+    for (qosrnp::size_type i = 0; same && i < al.size(); ++i) {
+        std::vector<qosrnp::size_type> neis;
+        qosrnp::for_each_neighbor(view, i, [&](qosrnp::size_type j, double) {
+            neis.push_back(j);
+        });
+        same = neis.size() == al[i].size_neighbor();
+        for (qosrnp::size_type j = 0; same && j < neis.size(); ++j)
+            same = al[i].neighbors()[j].tail()->id() == static_cast<qosrnp::id_type>(neis[j]);
+    }
+    std::cout << "edges: " << (same ? "identical" : "different") << std::endl;
+
+    // traversals accept the view.
+    qosrnp::PathTree<qosrnp::hop_type> vt = qosrnp::breadth_first_spt(view, 0);
+    qosrnp::PathTree<qosrnp::hop_type> at = qosrnp::breadth_first_spt(al, 0);
+    std::cout << "spt: " << (vt.weight == at.weight && vt.parent == at.parent
+                             ? "identical" : "different") << std::endl;
+    std::cout << "connected: " << qosrnp::is_connected(view, 0, dests) << " "
+              << qosrnp::is_connected(al, 0, dests) << std::endl;
+
+    // and so does the cover builder.
+    std::vector<qosrnp::hop_type> hops = qosrnp::hop_distances(view, 0);
+    auto covers = [&](qosrnp::size_type v, qosrnp::size_type t) {
+        return hops[v] < hops[t];
+    };
+    qosrnp::DenseCover vc = qosrnp::frontier_cover(view, dests.begin(), dests.end(), covers);
+    qosrnp::DenseCover ac = qosrnp::frontier_cover(al, dests.begin(), dests.end(), covers);
+    std::cout << "cover: " << (vc.minimum_set_cover() == ac.minimum_set_cover()
+                               ? "identical" : "different") << std::endl;
+
+    // switching a vertex on again restores its edges.
+    view.activate(101);
+    al.reactivate(101);
+    std::cout << "reactivated spt: "
+              << (qosrnp::hop_distances(view, 0) == qosrnp::hop_distances(al, 0)
+                  ? "identical" : "different") << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+#include <iostream>
+
+#include "../src/header.h"
+#include "../src/bitset.h"
+#include "../src/memo_cache.h"
+
+int main(void) {
+    qosrnp::MemoCache<int> cache(2);
+    qosrnp::DynamicBitset a(100), b(100), c(100);
+
+    a.set(1);
+    b.set(2);
+    c.set(3);
+    std::cout << "hash a == hash b: "
+              << (qosrnp::hash_bits(a) == qosrnp::hash_bits(b)) << std::endl;
+
+    cache.insert(a, 10);
+    cache.insert(b, 20);
+    const int* v = cache.find(a);
+    std::cout << "a: " << (v ? *v : -1) << std::endl;
+    // a was used last, so b is evicted.
+    cache.insert(c, 30);
+    std::cout << "b: " << (cache.find(b) ? "cached" : "evicted") << std::endl;
+    std::cout << "c: " << *cache.find(c) << std::endl;
+    std::cout << "size: " << cache.size() << ", hits: " << cache.hits()
+              << ", misses: " << cache.misses() << std::endl;
+
+    // a key of another size never matches.
+    std::cout << "resized a: "
+              << (cache.find(qosrnp::DynamicBitset(101)) ? "cached" : "missed") << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <stdexcept>
+
+#include "../src/parallel.h"
+
+int main(void) {
+    std::vector<unsigned>    seeds(1000), one(1000), many(1000);
+    std::default_random_engine e(1);
+
+    // each task draws from its own engine, so the results do not
+    // depend on the number of threads.
+    for (auto &s : seeds)
+        s = e();
+    auto task = [&](std::vector<unsigned>& res) {
+        return [&](qosrnp::size_type i) {
+            std::default_random_engine en(seeds[i]);
+            for (int k = 0; k < 1000; ++k)
+                res[i] += en() % 7;
+        };
+    };
+    qosrnp::parallel_for(seeds.size(), 1, task(one));
+    qosrnp::parallel_for(seeds.size(), 8, task(many));
+    std::cout << "1 vs 8 threads: " << (one == many ? "identical" : "different") << std::endl;
+
+    try {
+        qosrnp::parallel_for(100, 4, [](qosrnp::size_type i) {
+            if (i == 42)
+                throw std::range_error("task 42 failed.");
+        });
+    } catch (std::range_error err) {
+        std::cout << err.what() << std::endl;
+    }
+
+    return 0;
+}
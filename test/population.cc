@@ -0,0 +1,50 @@
+#include <iostream>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/bitset.h"
+#include "../src/population.h"
+
+int main(void) {
+    qosrnp::Population po(200);
+    qosrnp::DynamicBitset a(200), b(200);
+
+    for (qosrnp::size_type i = 0; i < 200; i += 7)
+        a.set(i);
+    for (qosrnp::size_type i = 0; i < 200; i += 5)
+        b.set(i);
+    po.push_back(a);
+    po.push_back(b);
+    std::cout << "size: " << po.size() << ", words: " << po.words() << std::endl;
+    std::cout << "counts: " << po.count(0) << " " << po.count(1) << std::endl;
+
+    // the crossover pool of two chromosomes is their union.
+    qosrnp::DynamicBitset pool(200);
+    po.unite(0, pool);
+    po.unite(1, pool);
+    std::cout << "pool: " << pool.count() << std::endl;
+
+    // chromosomes are copied word by word between populations.
+    qosrnp::Population mediate(200);
+    mediate.push_back(po, 1);
+    mediate.append(po);
+    std::cout << "mediate: " << mediate.size() << ", "
+              << (mediate.chromosome(0).count() == b.count() &&
+                  mediate.to_set(1) == po.to_set(0) ? "copied" : "different")
+              << std::endl;
+
+    std::set<qosrnp::size_type> s = po.to_set(0);
+    std::cout << "first genes:";
+    for (auto &g : s)
+        if (g < 30)
+            std::cout << " " << g;
+    std::cout << std::endl;
+
+    try {
+        po.push_back(qosrnp::DynamicBitset(100));
+    } catch (std::range_error err) {
+        std::cout << err.what() << std::endl;
+    }
+
+    return 0;
+}
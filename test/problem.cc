@@ -0,0 +1,89 @@
+#include <random>
+#include <iostream>
+#include <vector>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/problem.h"
+#include "../src/miscellaneous.h"
+#include "../src/dc1np.h"
+#include "../src/rdc1np.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::default_random_engine e(1);
+qosrnp::id_type id = 0;
+
+qosrnp::Node*
+random_node(qosrnp::node_type t) {
+    switch(t) {
+    case qosrnp::node_type::SENSOR:
+        return new qosrnp::Sensor(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 15, id++);
+    case qosrnp::node_type::RELAY:
+        return new qosrnp::Relay(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++);
+    case qosrnp::node_type::SINK:
+        return new qosrnp::Sink(qosrnp::Coordinate(d(e), d(e), 0.0), 10.0, 9999, id++);
+    }
+    return nullptr;
+}
+
+int main(void) {
+    qosrnp::Nodes nds;
+
+    for (int i = 0; i < 400; ++i) {
+        if (i < 1)
+            nds.push_back(random_node(qosrnp::node_type::SINK));
+        else if (i < 40)
+            nds.push_back(random_node(qosrnp::node_type::SENSOR));
+        else
+            nds.push_back(random_node(qosrnp::node_type::RELAY));
+    }
+    std::vector<qosrnp::Node*> nodes(nds.begin(), nds.end());
+
+    qosrnp::SolveContext ctx(nodes);
+    qosrnp::Problem pb(ctx);
+    std::cout << "sinks: " << pb.sinks().size() << ", sensors: " << pb.sensors().size()
+              << std::endl;
+    std::cout << "sensors suffice: " << (pb.sensors_suffice() ? "yes" : "no")
+              << ", feasible: " << (pb.feasible() ? "yes" : "no")
+              << ", late sensors: " << pb.late_sensors().size() << std::endl;
+
+    // solves on masks of one problem give the same relays as solves
+    // on contexts with the same relays switched off.
+    std::default_random_engine en(3), en1(7), en2(7);
+    bool same = true;
+    for (int k = 0; k < 10; ++k) {
+        qosrnp::DynamicBitset on = pb.mask();
+        qosrnp::SolveContext sub(nodes);
+        for (qosrnp::size_type i = pb.sensors().size() + 1; i < pb.size(); ++i)
+            if (qosrnp::rand_range(en, 0, 3) == 0) {
+                on.reset(i);
+                sub.deactivate(i);
+            }
+        auto r1 = qosrnp::dc1np(pb, on), r2 = qosrnp::dc1np(sub),
+             r3 = qosrnp::rdc1np(en1, pb, on), r4 = qosrnp::rdc1np(en2, sub);
+        if (r1.status() != r2.status() || r3.status() != r4.status() ||
+            (r1 && r1.value() != r2.value()) || (r3 && r3.value() != r4.value()))
+            same = false;
+    }
+    std::cout << "masks vs contexts: " << (same ? "same" : "different") << std::endl;
+
+    // no relay is placed if none is switched on, and the result
+    // tells why.
+    qosrnp::DynamicBitset none = pb.mask();
+    for (qosrnp::size_type i = pb.sensors().size() + 1; i < pb.size(); ++i)
+        none.reset(i);
+    std::cout << "no relays: " << qosrnp::dc1np(pb, none).status() << std::endl;
+
+    // sensors send to the nearest of many sinks, so fewer relays are
+    // needed than with one.
+    for (qosrnp::size_type i = 1; i < 4; ++i)
+        nodes[i] = new qosrnp::Sink(nodes[i]->coordinate(), 10.0, 9999, nodes[i]->id());
+    qosrnp::SolveContext many(nodes);
+    qosrnp::Problem mp(many);
+    auto one = qosrnp::dc1np(pb, pb.mask()), four = qosrnp::dc1np(mp, mp.mask());
+    std::cout << "sinks: " << mp.sinks().size() << ", relays: "
+              << (one ? one.value().size() : 0) << " with one sink, "
+              << (four ? four.value().size() : 0) << " with four" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+#include <iostream>
+#include <set>
+#include <stdexcept>
+
+#include "../src/header.h"
+#include "../src/result.h"
+
+int main(void) {
+    qosrnp::Result<std::set<qosrnp::size_type>> ok(std::set<qosrnp::size_type>{1, 2, 3}),
+                                                failed(qosrnp::solve_status::NO_COVER);
+
+    std::cout << "ok: " << ok.ok() << ", " << ok.status()
+              << ", size " << ok.value().size() << std::endl;
+    std::cout << "failed: " << static_cast<bool>(failed) << ", " << failed.status()
+              << ", size " << failed.value_or(std::set<qosrnp::size_type>()).size()
+              << std::endl;
+
+    // reading the value of a failed result is a misuse.
+    try {
+        failed.value();
+        std::cout << "value of failed: read" << std::endl;
+    } catch (std::range_error err) {
+        std::cout << "value of failed: " << err.what() << std::endl;
+    }
+    // so is an ok status without a value.
+    try {
+        qosrnp::Result<int> r(qosrnp::solve_status::OK);
+        std::cout << "ok without value: made" << std::endl;
+    } catch (std::range_error err) {
+        std::cout << "ok without value: " << err.what() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <vector>
+
+#include "../src/sampling.h"
+
+int main(void) {
+    std::uniform_int_distribution<unsigned> d(0, 9);
+    std::default_random_engine e(std::time(0));
+    qosrnp::FenwickTree<qosrnp::size_type>    tree(100);
+    std::vector<qosrnp::size_type>            vec(100, 0);
+    bool                                      same = true;
+
+    for (int i = 0; i < 1000; ++i) {
+        qosrnp::size_type k = d(e) * 10 + d(e);
+        vec[k] = d(e);
+        tree.set(k, vec[k]);
+    }
+    // prefix sums, and the first item reaching each of them.
+    qosrnp::size_type sum = 0;
+    for (qosrnp::size_type i = 0; i < vec.size(); ++i) {
+        sum += vec[i];
+        same = same && tree.prefix(i + 1) == sum;
+        if (vec[i])
+            same = same && tree.lower_bound(sum) == i &&
+                   tree.lower_bound(sum - vec[i] + 1) == i;
+    }
+    same = same && tree.lower_bound(sum + 1) == tree.size();
+    std::cout << "total: " << tree.total() << ", expected: " << sum << std::endl;
+    std::cout << "fenwick tree: " << (same ? "identical" : "different") << std::endl;
+
+    // draw frequencies of an alias table follow its weights.
+    std::vector<double> ws = {1.0, 0.0, 2.0, 3.0, 4.0};
+    std::vector<int>    cnt(ws.size(), 0);
+    qosrnp::AliasTable  table(ws);
+    for (int i = 0; i < 100000; ++i)
+        ++cnt[table(e)];
+    std::cout << "alias table:";
+    for (qosrnp::size_type i = 0; i < ws.size(); ++i)
+        std::cout << " " << ws[i] / 10.0 << "/" << cnt[i] / 100000.0;
+    std::cout << std::endl;
+
+    // the same seed draws the same items.
+    std::default_random_engine e1(1), e2(1);
+    for (int i = 0; i < 100; ++i)
+        same = same && table(e1) == table(e2);
+    std::cout << "reproducible: " << same << std::endl;
+
+    return 0;
+}